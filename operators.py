@@ -167,11 +167,15 @@ def tournament_selection_with_elitism(
 
 
 def _varAnd(
-    population: list[Individual], pop2: list[Individual], toolbox: Toolbox, cxpb: float, mutpb: float
+    population: list[Individual], pop2: list[Individual], toolbox: Toolbox, cxpb: float, mutpb: float,
+    pending: list | None = None
 ) -> list[Individual]:
     """
     Modified version of `varAnd` from DEAP.
 
+    If `pending` is given, each finished offspring with an invalid fitness is submitted with `toolbox.submit`
+    and appended to `pending` together with its future, so it is scored while the next offspring are produced.
+
     Source: https://github.com/DEAP/deap/blob/master/deap/algorithms.py
     """
     i: cython.int
@@ -194,6 +198,10 @@ def _varAnd(
             offspring[i], = toolbox.mutate(offspring[i])
             del offspring[i].fitness.values
 
+        # The offspring doesn't change anymore in this generation
+        if pending is not None and not offspring[i].fitness.valid:
+            pending.append((offspring[i], toolbox.submit(offspring[i])))
+
     return offspring
 
 
@@ -239,15 +247,21 @@ def _eaSimple(
 
         start_mutate = time.time()
         # Vary the pool of individuals
-        offspring = _varAnd(offspring, pop2, toolbox, cxpb, mutpb)
+        # If the toolbox can submit individuals, they are scored in the background while the others are varied
+        pending = [] if hasattr(toolbox, 'submit') else None
+        offspring = _varAnd(offspring, pop2, toolbox, cxpb, mutpb, pending)
         if verbose:
             print(f'Cross+Mut: {time.time() - start_mutate:.4f}s')
 
         start_evaluate = time.time()
         # Evaluate the individuals with an invalid fitness
-        invalid_ind = [ind for ind in offspring if not ind.fitness.valid]
+        if pending is None:
+            invalid_ind = [ind for ind in offspring if not ind.fitness.valid]
+            fitnesses = toolbox.map(toolbox.evaluate, invalid_ind)
+        else:
+            invalid_ind = [ind for ind, _ in pending]
+            fitnesses = [(future.result(),) for _, future in pending]
 
-        fitnesses = toolbox.map(toolbox.evaluate, invalid_ind)
         for ind, fit in zip(invalid_ind, fitnesses):
             ind.fitness.values = fit
         if verbose:
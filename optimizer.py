@@ -1,13 +1,12 @@
 import argparse
 from array import array
-from collections import defaultdict
 import datetime
 from functools import partial
+import itertools
 import os
 import random
 import re
 import time
-import threading
 
 from deap import base, creator, tools
 import numpy as np
@@ -26,10 +25,13 @@ parser.add_argument('data', choices=TEST_DATA, help='Input dataset - a, b, c, d,
 # Common parameters for all algorithms
 parser.add_argument('--order_init', default='default', choices=['adaptive', 'random', 'default'], help='Method for initializing the order of streets.')
 parser.add_argument('--times_init', default='default', choices=['scaled', 'default'], help='Method for initializing green light durations.')
+parser.add_argument('--adaptive_starts', default=1, type=int, help='Number of adaptive schedule variants built in parallel as the initial individuals (adaptive order only).')
 parser.add_argument('--mutation_bit_rate', default=10, type=float, help='If between 0-1, it defines the probability of mutating each bit. If >= 1, it defines the expected value of bits to mutate.')
 
 parser.add_argument('--seed', default=42, type=int, help='Random seed.')
 parser.add_argument('--threads', default=None, type=int, help='Number of threads for parallel execution.')
+parser.add_argument('--pin_threads', default=False, action='store_true', help='Pin the evaluation workers to CPUs (Genetic Algorithm with --threads only, Linux only).')
+parser.add_argument('--cache', default=65536, type=int, help='Number of scores kept in the cache shared by all simulations (0 disables the cache).')
 parser.add_argument('--verbose', default=False, action='store_true', help='Print detailed information during execution.')
 parser.add_argument('--no-save', default=False, action='store_true', help='Do not save results and plots.')
 parser.add_argument('--logdir', default=None, type=str, help='Custom name for the log directory.')
@@ -41,6 +43,7 @@ parser.add_argument('--crossover', default=0.6, type=float, help='Crossover prob
 parser.add_argument('--mutation', default=0.4, type=float, help='Mutation probability (Genetic Algorithm only).')
 parser.add_argument('--elitism', default=0.05, type=float, help='Elitism rate (Genetic Algorithm only).')
 parser.add_argument('--tournsize', default=3, type=int, help='Tournament size for selection (Genetic Algorithm only).')
+parser.add_argument('--islands', default=0, type=int, help='Number of islands of the native island model, each with its own population evolved by its own thread; 0 runs the DEAP implementation (Genetic Algorithm only).')
 
 # Hyperparameters for Hill Climbing and Simulated Annealing
 parser.add_argument('--instances', default=1, type=int, help='Number of independent instances to run in parallel (Hill Climbing and Simulated Annealing).')
@@ -52,12 +55,20 @@ class Optimizer:
     def __init__(self, args):
         self.plan = create_city_plan(args.data)
         self._args = args
-        self._simulations = defaultdict(partial(default_simulation, city_plan=self.plan))
+        # Duplicate individuals are scored only once by any of the simulations
+        self._cache = ScoreCache(args.cache) if args.cache > 0 else None
+        # Replicas are leased to the threads of the executor, at most one for each thread
+        self._simulations = SimulationPool(self.plan, max_replicas=args.threads or 1, cache=self._cache)
+        self._pool = None
         self._toolbox = base.Toolbox()
         self._stats = tools.Statistics(lambda ind: ind.fitness.values)
         self._hof = tools.HallOfFame(1)
         self._logbook = None
         self._elapsed_time = None
+        # Probability of mutating each street, also used by the native island model
+        self._indpb = None
+        # Schedules of the adaptive variants the initial individuals are taken from
+        self._adaptive_schedules = None
 
         random.seed(args.seed)
         np.random.seed(args.seed)
@@ -72,6 +83,13 @@ class Optimizer:
             pool = concurrent.futures.ThreadPoolExecutor(max_workers=self._args.threads)
             self._toolbox.register('map', pool.map)
 
+            if self._args.algorithm == 'ga':
+                # Offspring are scored in the background while the rest of the generation is produced
+                self._pool = EvaluationPool(
+                    self.plan, threads=self._args.threads, cache=self._cache, pin_threads=self._args.pin_threads
+                )
+                self._toolbox.register('submit', self._submit)
+
         creator.create('FitnessMax', base.Fitness, weights=(1.0,))
         creator.create('Individual', list, fitness=creator.FitnessMax)
 
@@ -112,6 +130,7 @@ class Optimizer:
             indpb = mutation_bit_rate / PARAMETERS[self._args.data]
         else:
             raise ValueError('Mutation bit rate must be >= 0.')
+        self._indpb = indpb
         self._toolbox.register('mutate', mutation, indpb=indpb, low=green_min, up=green_max)
 
         norm_score = partial(normalized_score, data=self._args.data)
@@ -123,17 +142,31 @@ class Optimizer:
         self._stats.register('avg', lambda x: f'{int(np.mean(x)):,}')
 
     def _create_individual(self, simulation):
-        if len(simulation.non_trivial_schedules()) == 0 or self._args.order_init == 'random':
-            # Schedules are not created yet or
-            # For random order initialization, we need to create new schedules each time
-            simulation.create_schedules(
-                order=self._args.order_init,
-                times=self._args.times_init,
-                divisor=BEST_DIVISOR[self._args.data],
-            )
-
         # Relative order is required for the operators (order crossover) to work correctly
-        schedules = simulation.non_trivial_schedules(relative_order=True)
+        if self._args.order_init == 'adaptive':
+            if self._adaptive_schedules is None:
+                # The variants are built once in parallel and the individuals cycle through them, the best first
+                # Adaptive order shifts the slots of the streets, so it has its own best divisor
+                variants = simulation.adaptive_variants(
+                    self._args.adaptive_starts,
+                    times=self._args.times_init,
+                    divisor=ADAPTIVE_DIVISOR[self._args.data],
+                    seed=self._args.seed,
+                    threads=self._args.threads or 1,
+                    relative_order=True,
+                )
+                self._adaptive_schedules = itertools.cycle([variant.schedules for variant in variants])
+            schedules = next(self._adaptive_schedules)
+        else:
+            if len(simulation.non_trivial_schedules()) == 0 or self._args.order_init == 'random':
+                # Schedules are not created yet or
+                # For random order initialization, we need to create new schedules each time
+                simulation.create_schedules(
+                    order=self._args.order_init,
+                    times=self._args.times_init,
+                    divisor=BEST_DIVISOR[self._args.data],
+                )
+            schedules = simulation.non_trivial_schedules(relative_order=True)
 
         # Convert schedules from lists to array.arrays to speed up the optimization
         individual = [
@@ -142,13 +175,59 @@ class Optimizer:
         return individual
 
     def _evaluate(self, individual):
-        # Keep reusing the same simulation object for the same thread
-        simulation = self._simulations[threading.get_ident()]
-        # Individual is in the relative_order format
-        simulation.set_non_trivial_schedules(individual, relative_order=True)
-        fitness = simulation.score()
+        with self._simulations.acquire() as simulation:
+            # Individual is in the relative_order format
+            simulation.set_non_trivial_schedules(individual, relative_order=True)
+            fitness = simulation.score()
         return fitness,
 
+    def _submit(self, individual):
+        # Individual is in the relative_order format
+        return self._pool.submit(individual, relative_order=True)
+
+    def _island_model(self, population, verbose):
+        """
+        Run the native island model genetic algorithm starting from the individuals of the population.
+
+        Returns the logbook with the statistics of each generation over all islands.
+        """
+        parameters = IslandParameters()
+        parameters.islands = self._args.islands
+        parameters.population = self._args.population
+        parameters.generations = self._args.generations
+        parameters.crossover = self._args.crossover
+        parameters.mutation = self._args.mutation
+        parameters.mutation_indpb = self._indpb
+        parameters.max_time = self.plan.duration
+        parameters.elitism = self._args.elitism
+        parameters.tournsize = self._args.tournsize
+        parameters.seed = self._args.seed
+        initial = [[(list(order), list(times)) for order, times in individual] for individual in population]
+        result = island_genetic_algorithm(self.plan, initial, parameters, self._cache)
+
+        norm_score = partial(normalized_score, data=self._args.data)
+        logbook = tools.Logbook()
+        logbook.header = ['gen', 'nevals'] + self._stats.fields
+        # The history is ordered by generations
+        for gen, generations in itertools.groupby(result.history, key=lambda generation: generation.generation):
+            generations = list(generations)
+            max_score = max(generation.max_score for generation in generations)
+            avg_score = np.mean([generation.average_score for generation in generations])
+            logbook.record(
+                gen=gen, nevals=sum(generation.evaluations for generation in generations),
+                norm_max=norm_score(max_score), max=f'{max_score:,}',
+                norm_avg=norm_score(avg_score), avg=f'{int(avg_score):,}'
+            )
+            if verbose:
+                print(logbook.stream)
+        if verbose:
+            print(f'Migrations: {result.migrations:,}')
+
+        best = creator.Individual((array('L', order), array('L', times)) for order, times in result.schedules)
+        best.fitness.values = (result.score,)
+        self._hof.update([best])
+        return logbook
+
     def _save_data_plots(self, logdir, show_plot=False):
         import matplotlib.pyplot as plt
         import matplotlib.ticker as ticker
@@ -261,7 +340,10 @@ class Optimizer:
         if verbose:
             print(f'Population created: {time.time() - start:.4f}s')
 
-        if self._args.algorithm == 'ga':
+        if self._args.algorithm == 'ga' and self._args.islands > 0:
+            self._logbook = self._island_model(population, verbose)
+
+        elif self._args.algorithm == 'ga':
             population, self._logbook = genetic_algorithm(
                 population, self._toolbox, self._args.crossover, self._args.mutation, self._args.generations, **kwargs
             )
@@ -281,6 +363,8 @@ class Optimizer:
 
         best_fitness = int(self._hof.keys[0].values[0])
         print(f'Best fitness: {best_fitness:,} ({100 * normalized_score(best_fitness, self._args.data):.2f} %)')
+        if verbose and self._cache is not None:
+            print(f'Score cache: {self._cache.hits:,} hits, {self._cache.misses:,} misses')
 
         if save_statistics:
             self._save_statistics()
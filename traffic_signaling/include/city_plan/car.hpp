@@ -1,9 +1,9 @@
 #ifndef CITY_PLAN_CAR_HPP
 #define CITY_PLAN_CAR_HPP
 
-#include <vector>
 #include <functional>
 #include <ranges>
+#include <span>
 
 #include "city_plan/street.hpp"
 
@@ -12,6 +12,7 @@ namespace city_plan {
  * Car in the city plan.
  *
  * Contains all "static" information about a car known from the input data.
+ * The path is a view into the flat path storage of the city plan, see `CityPlan::path_street_ids`.
  */
 class Car {
 public:
@@ -19,10 +20,11 @@ public:
      * Construct a car object.
      *
      * @param id ID of the car.
-     * @param path Path of streets the car has to travel.
+     * @param street_ids IDs of the streets the car has to travel; the storage must outlive the car.
+     * @param streets Streets of the city plan indexed by street IDs; the storage must outlive the car.
      */
-    Car(unsigned long id, std::vector<std::reference_wrapper<const Street>> &&path)
-        : id_(id), path_(std::move(path)) {}
+    Car(unsigned long id, std::span<const unsigned long> street_ids, const Street *streets)
+        : id_(id), street_ids_(street_ids), streets_(streets) {}
 
     /**
      * Return the ID of the car.
@@ -32,10 +34,19 @@ public:
     }
 
     /**
-     * Return the path the car has to travel.
+     * Return the IDs of the streets the car has to travel.
      */
-    const std::vector<std::reference_wrapper<const Street>> &path() const {
-        return path_;
+    std::span<const unsigned long> street_ids() const {
+        return street_ids_;
+    }
+
+    /**
+     * Return the path the car has to travel as a random-access view of streets.
+     */
+    auto path() const {
+        return street_ids_ | std::views::transform([streets = streets_](unsigned long id) -> const Street & {
+            return streets[id];
+        });
     }
 
     /**
@@ -45,7 +56,7 @@ public:
         unsigned long duration = 0;
         // The car path begins at the end of the first street
         // so we skip the first street
-        for (const Street &s: path_ | std::views::drop(1)) {
+        for (const Street &s: path() | std::views::drop(1)) {
             duration += s.length();
         }
         return duration;
@@ -54,8 +65,10 @@ public:
 private:
     /** ID of the car. */
     unsigned long id_;
-    /** Path of streets the car has to travel. */
-    std::vector<std::reference_wrapper<const Street>> path_;
+    /** IDs of the streets the car has to travel. */
+    std::span<const unsigned long> street_ids_;
+    /** Streets of the city plan indexed by street IDs. */
+    const Street *streets_;
 };
 }
 
@@ -1,14 +1,16 @@
 #ifndef CITY_PLAN_CITY_PLAN_HPP
 #define CITY_PLAN_CITY_PLAN_HPP
 
-#include <fstream>
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 #include <string_view>
-#include <unordered_map>
+#include <optional>
 #include <ranges>
 
 #include "city_plan/intersection.hpp"
+#include "city_plan/name_table.hpp"
 #include "city_plan/street.hpp"
 #include "city_plan/car.hpp"
 
@@ -23,9 +25,19 @@ public:
     /**
      * Construct a city plan from the input data file.
      *
+     * The cars are parsed on multiple threads, but the city plan is the same for any number of threads.
+     *
      * @param filename Path of the file containing the input data.
+     * @param threads Maximum number of threads parsing the cars, by default the number of hardware threads.
      */
-    explicit CityPlan(const std::string &filename);
+    explicit CityPlan(const std::string &filename, unsigned long threads = default_threads());
+
+    /**
+     * Return the number of hardware threads, or 1 if it can't be determined.
+     */
+    static unsigned long default_threads() {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
 
     /**
      * Return the intersections in the city plan.
@@ -76,13 +88,98 @@ public:
         return intersections_ | std::views::filter(&Intersection::non_trivial);
     }
 
+    /**
+     * Return the IDs of the starting intersections of the streets indexed by street IDs.
+     */
+    const std::vector<unsigned long> &street_starts() const {
+        return street_starts_;
+    }
+
+    /**
+     * Return the IDs of the ending intersections of the streets indexed by street IDs.
+     */
+    const std::vector<unsigned long> &street_ends() const {
+        return street_ends_;
+    }
+
+    /**
+     * Return the lengths of the streets indexed by street IDs.
+     */
+    const std::vector<unsigned long> &street_lengths() const {
+        return street_lengths_;
+    }
+
+    /**
+     * Return the total numbers of cars that use the streets indexed by street IDs.
+     */
+    const std::vector<unsigned long> &street_total_cars() const {
+        return street_total_cars_;
+    }
+
+    /**
+     * Return the offsets of the car paths in `path_street_ids` indexed by car IDs,
+     * followed by the total length of all paths.
+     *
+     * The path of the car with ID `i` is `path_street_ids[path_offsets[i]:path_offsets[i + 1]]`.
+     */
+    const std::vector<unsigned long> &path_offsets() const {
+        return path_offsets_;
+    }
+
+    /**
+     * Return the IDs of the streets in the paths of all cars, one path after another.
+     */
+    const std::vector<unsigned long> &path_street_ids() const {
+        return path_street_ids_;
+    }
+
+    /**
+     * Return the free-flow durations from the end of each street in the paths of all cars to their destinations,
+     * in the same order as `path_street_ids`.
+     *
+     * The duration is the total length of the streets following the street in the path of the car,
+     * i.e. the time the car needs to reach its destination after passing the traffic light without any more waiting.
+     */
+    const std::vector<unsigned long> &path_remaining_durations() const {
+        return path_remaining_durations_;
+    }
+
+    /**
+     * Return the offsets of the used streets in `used_street_ids` indexed by intersection IDs,
+     * followed by the number of all used streets.
+     *
+     * The used streets of the intersection with ID `i` are `used_street_ids[used_street_offsets[i]:used_street_offsets[i + 1]]`,
+     * in the same order as `Intersection::used_streets`.
+     */
+    const std::vector<unsigned long> &used_street_offsets() const {
+        return used_street_offsets_;
+    }
+
+    /**
+     * Return the IDs of the used streets of all intersections, one intersection after another.
+     */
+    const std::vector<unsigned long> &used_street_ids() const {
+        return used_street_ids_;
+    }
+
     /**
      * Return the ID of a street given its name.
      *
+     * Throws `std::out_of_range` if there is no street with the name.
+     *
      * @param name Name of the street.
      */
     unsigned long street_id(std::string_view name) const {
-        return street_mapping_.at(name);
+        return street_names_.at(name);
+    }
+
+    /**
+     * Return the name of a street given its ID.
+     *
+     * @param street_id ID of the street.
+     */
+    std::string_view street_name(unsigned long street_id) const {
+        return street_names_.name(street_id);
     }
 
     /**
@@ -90,29 +187,63 @@ public:
      */
     unsigned long upper_bound() const;
 
-private:
     /**
-     * Construct a city plan from an input stream.
+     * Return the earliest time any car can reach the traffic light of the given intersection,
+     * or nothing if no car ever waits at it.
      *
-     * @param file Input file stream to read from.
+     * The time assumes that none of the cars has to wait at a traffic light, so it's a lower bound
+     * for the time the first car reaches the traffic light with any schedules.
+     *
+     * @param intersection_id ID of the intersection.
      */
-    explicit CityPlan(std::ifstream &file);
+    std::optional<unsigned long> earliest_arrival(unsigned long intersection_id) const;
+
+private:
+    /** Cars parsed from one chunk of the car section of the input data. */
+    struct CarChunk {
+        /** Number of streets in the paths of the cars, in the order of the cars. */
+        std::vector<unsigned long> path_lengths;
+        /** IDs of the streets in the paths of the cars, one path after another. */
+        std::vector<unsigned long> street_ids;
+        /** Numbers of cars in the chunk using the streets indexed by street IDs. */
+        std::vector<unsigned long> total_cars;
+    };
 
     /**
-     * Read streets from the input file.
+     * Read streets from the beginning of the input data and remove them from the view.
      *
-     * @param file Input file stream to read from.
+     * @param data Input data starting with the street section.
      * @param count Number of streets to read.
      */
-    void read_streets(std::ifstream &file, unsigned long count);
+    void read_streets(std::string_view &data, unsigned long count);
 
     /**
-     * Read cars from the input file.
+     * Read cars from the input data.
      *
-     * @param file Input file stream to read from.
+     * The data is split into line-aligned chunks parsed on multiple threads,
+     * and the chunks are stitched together in their order, so the car IDs don't depend on the number of threads.
+     *
+     * @param data Input data containing only the car section.
      * @param count Number of cars to read.
+     * @param threads Maximum number of threads parsing the cars.
+     */
+    void read_cars(std::string_view data, unsigned long count, unsigned long threads);
+
+    /**
+     * Parse the cars in one chunk of the car section.
+     *
+     * This method only reads the streets and their names, so it can be called from multiple threads at once.
+     *
+     * @param data Chunk of the car section consisting of whole lines.
      */
-    void read_cars(std::ifstream &file, unsigned long count);
+    CarChunk read_car_chunk(std::string_view data) const;
+
+    /**
+     * Add the used streets to the intersections and index them in `used_street_offsets_` and `used_street_ids_`.
+     *
+     * The used streets of every intersection are added in the increasing order of street IDs.
+     */
+    void index_used_streets();
 
     /** Duration of the simulation in seconds. */
     unsigned long duration_;
@@ -124,8 +255,31 @@ private:
     std::vector<Car> cars_;
     /** Bonus awarded for each car that reaches its destination before the end of the simulation. */
     unsigned long bonus_;
-    /** Mapping from street name to street ID. */
-    std::unordered_map<std::string_view, unsigned long> street_mapping_;
+    /** Names of the streets indexed by street IDs. */
+    NameTable street_names_;
+
+    // Flat copies of the street data, so that they can be shared without touching the street objects
+
+    /** IDs of the starting intersections of the streets indexed by street IDs. */
+    std::vector<unsigned long> street_starts_;
+    /** IDs of the ending intersections of the streets indexed by street IDs. */
+    std::vector<unsigned long> street_ends_;
+    /** Lengths of the streets indexed by street IDs. */
+    std::vector<unsigned long> street_lengths_;
+    /** Total numbers of cars that use the streets indexed by street IDs. */
+    std::vector<unsigned long> street_total_cars_;
+
+    /** Offsets of the car paths in `path_street_ids_` indexed by car IDs, followed by its size. */
+    std::vector<unsigned long> path_offsets_;
+    /** IDs of the streets in the paths of all cars; the cars hold views into this vector. */
+    std::vector<unsigned long> path_street_ids_;
+    /** Free-flow durations from the end of each street in `path_street_ids_` to the destination of its car. */
+    std::vector<unsigned long> path_remaining_durations_;
+
+    /** Offsets of the used streets in `used_street_ids_` indexed by intersection IDs, followed by its size. */
+    std::vector<unsigned long> used_street_offsets_;
+    /** IDs of the used streets of all intersections. */
+    std::vector<unsigned long> used_street_ids_;
 };
 }
 
@@ -0,0 +1,100 @@
+#ifndef CITY_PLAN_NAME_TABLE_HPP
+#define CITY_PLAN_NAME_TABLE_HPP
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace city_plan {
+/**
+ * Table of interned names indexed by consecutive IDs.
+ *
+ * All names are stored one after another in a single string arena, and the name with ID `i` is
+ * `arena[offsets[i]:offsets[i + 1]]`. Names are looked up using an open-addressing hash index
+ * (linear probing) storing only the IDs of the names, so the whole table takes a few allocations
+ * instead of one (or more) for every name.
+ */
+class NameTable {
+public:
+    /**
+     * Reserve memory for the given number of names.
+     *
+     * @param count Expected number of names.
+     * @param characters Expected total number of characters of the names.
+     */
+    void reserve(unsigned long count, unsigned long characters = 0);
+
+    /**
+     * Add the name to the table and return its ID.
+     *
+     * The IDs are assigned consecutively starting from 0.
+     *
+     * @param name Name to add; it must not be in the table yet.
+     */
+    unsigned long add(std::string_view name);
+
+    /**
+     * Return the name with the given ID.
+     *
+     * The returned view is valid until the next name is added.
+     *
+     * @param id ID of the name.
+     */
+    std::string_view name(unsigned long id) const {
+        return std::string_view{arena_}.substr(offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+
+    /**
+     * Return the ID of the given name, or nothing if it's not in the table.
+     *
+     * @param name Name to look up.
+     */
+    std::optional<unsigned long> find(std::string_view name) const;
+
+    /**
+     * Return the ID of the given name.
+     *
+     * Throws `std::out_of_range` if the name is not in the table.
+     *
+     * @param name Name to look up.
+     */
+    unsigned long at(std::string_view name) const;
+
+    /**
+     * Return the number of names in the table.
+     */
+    unsigned long size() const {
+        return static_cast<unsigned long>(offsets_.size() - 1);
+    }
+
+private:
+    /**
+     * Return the position of the name in the index: either the slot holding its ID or the empty slot
+     * where its ID belongs.
+     *
+     * @param name Name to look up.
+     */
+    unsigned long slot(std::string_view name) const;
+
+    /**
+     * Rebuild the index with the given number of slots.
+     *
+     * @param slots Number of slots, a power of two.
+     */
+    void rehash(unsigned long slots);
+
+    /** Marker of an empty slot in the index. */
+    static constexpr auto EMPTY = std::numeric_limits<unsigned long>::max();
+
+    /** All names stored one after another. */
+    std::string arena_;
+    /** Offsets of the names in the arena indexed by IDs, followed by the size of the arena. */
+    std::vector<unsigned long> offsets_{0};
+    /** Open-addressing index of the names containing their IDs or `EMPTY`; its size is a power of two. */
+    std::vector<unsigned long> index_;
+};
+}
+
+#endif
@@ -1,8 +1,6 @@
 #ifndef CITY_PLAN_STREET_HPP
 #define CITY_PLAN_STREET_HPP
 
-#include <string>
-
 namespace city_plan {
 // necessary forward declaration to resolve circular dependency
 class Intersection;
@@ -11,6 +9,7 @@ class Intersection;
  * Street in the city plan.
  *
  * Contains all "static" information about a street known from the input data.
+ * The name of the street is not stored here, because it's only needed for I/O; see `CityPlan::street_name`.
  */
 class Street {
 public:
@@ -20,13 +19,10 @@ public:
      * @param id ID of the street.
      * @param start Starting intersection of the street.
      * @param end Ending intersection of the street.
-     * @param name Name of the street.
      * @param length Length of the street in seconds it takes to drive through it.
      */
-    Street(unsigned long id, const Intersection &start, const Intersection &end,
-           std::string &&name, unsigned long length)
-        : id_(id), start_(start), end_(end),
-          name_(std::move(name)), length_(length) {}
+    Street(unsigned long id, const Intersection &start, const Intersection &end, unsigned long length)
+        : id_(id), start_(start), end_(end), length_(length) {}
 
     /**
      * Return the ID of the street.
@@ -50,19 +46,14 @@ public:
     }
 
     /**
-     * Return the name of the street.
-     */
-    const std::string &name() const {
-        return name_;
-    }
-
-    /**
-     * Increase the number of cars that use this street by one.
+     * Increase the number of cars that use this street.
      *
      * This method is only used during CityPlan initialization.
+     *
+     * @param count Number of cars to add.
      */
-    void add_car() {
-        ++total_cars_;
+    void add_cars(unsigned long count) {
+        total_cars_ += count;
     }
 
     /**
@@ -95,8 +86,6 @@ private:
     const Intersection &start_;
     /** Ending intersection of the street. */
     const Intersection &end_;
-    /** Name of the street. */
-    std::string name_;
     /** Length of the street in seconds it takes to drive through it. */
     unsigned long length_;
     /** Total number of cars that use this street. */
@@ -0,0 +1,112 @@
+#ifndef EVALUATION_DAEMON_DAEMON_HPP
+#define EVALUATION_DAEMON_DAEMON_HPP
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "city_plan/city_plan.hpp"
+#include "evaluation_daemon/protocol.hpp"
+#include "simulation/evaluation_pool.hpp"
+
+namespace evaluation_daemon {
+/**
+ * Daemon scoring schedules sent over a Unix domain socket.
+ *
+ * Loaded city plans and their evaluation pools stay resident, so they are shared by all clients
+ * and the startup cost is paid only once.
+ */
+class Daemon {
+public:
+    /**
+     * Construct a daemon listening on the given socket path.
+     *
+     * @param socket_path Path of the socket; an existing file at this path is replaced.
+     * @param threads Number of worker threads of each evaluation pool.
+     */
+    Daemon(std::string socket_path, unsigned long threads);
+
+    Daemon(const Daemon &) = delete;
+    Daemon &operator=(const Daemon &) = delete;
+
+    /**
+     * Stop the daemon, disconnect the clients and remove the socket.
+     */
+    ~Daemon();
+
+    /**
+     * Accept and serve the clients until `stop()` is called.
+     */
+    void serve();
+
+    /**
+     * Make `serve()` return.
+     *
+     * This method only sets a flag, so it is safe to call from a signal handler.
+     */
+    void stop() {
+        stop_requested_ = true;
+    }
+
+private:
+    /** City plan loaded by the daemon together with its evaluation pool. */
+    struct LoadedPlan {
+        /** City plan loaded from the file. */
+        std::unique_ptr<city_plan::CityPlan> city_plan;
+        /** Evaluation pool for the city plan. */
+        std::unique_ptr<simulation::EvaluationPool> pool;
+    };
+
+    /**
+     * Serve the requests of one client until it disconnects.
+     *
+     * @param connection Connection to the client.
+     */
+    void handle(Connection connection);
+
+    /**
+     * Load the city plan from the file, or find it if it's already loaded, and return its ID.
+     *
+     * @param filename Path of the input file.
+     */
+    Word load(const std::string &filename);
+
+    /**
+     * Read a batch of schedules from the connection, score them and return the scores.
+     *
+     * @param connection Connection to the client.
+     */
+    std::vector<Word> score(Connection &connection);
+
+    /** Path of the socket. */
+    std::string socket_path_;
+    /** Number of worker threads of each evaluation pool. */
+    unsigned long threads_;
+    /** File descriptor of the listening socket. */
+    int socket_;
+    /** Whether `stop()` was called. */
+    std::atomic<bool> stop_requested_ = false;
+
+    /** Mutex guarding the loaded plans, the connected clients and their threads. */
+    std::mutex mutex_;
+    /** Loaded city plans indexed by their IDs; a deque keeps them in place when more plans are loaded. */
+    std::deque<LoadedPlan> plans_;
+    /** IDs of the loaded city plans indexed by their file names. */
+    std::unordered_map<std::string, Word> plan_ids_;
+    /** Sockets of the connected clients, shut down when the daemon stops. */
+    std::unordered_set<int> client_sockets_;
+
+    /** Threads serving the clients. */
+    std::vector<std::jthread> clients_;
+    /** IDs of the client threads that are done, joined when the next client connects. */
+    std::unordered_set<std::thread::id> finished_clients_;
+};
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef EVALUATION_DAEMON_PROTOCOL_HPP
+#define EVALUATION_DAEMON_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Binary protocol of the evaluation daemon.
+ *
+ * All values are sent as 64-bit unsigned integers ("words") in the native byte order,
+ * because the daemon and its clients always run on the same machine. Strings are sent as their length
+ * followed by their bytes padded with zeros to a multiple of the word size.
+ *
+ * Requests:
+ * - `LOAD filename` loads the city plan from the file (or reuses it if it's already loaded)
+ *   and replies with `OK plan_id`.
+ * - `SCORE plan_id relative_order batch_size` followed by `batch_size` sets of schedules scores
+ *   the schedules and replies with `OK batch_size score...`. Each set is sent as the number of schedules
+ *   followed by a schedule for every non-trivial intersection in the order of
+ *   `CityPlan::non_trivial_intersections()`; each schedule is sent as
+ *   `length order[0]...order[length - 1] times[0]...times[length - 1]`.
+ *
+ * A request that fails is answered with `ERROR message`, and the connection can be used further.
+ * A request of unknown type is answered with `ERROR message` and the connection is closed.
+ */
+namespace evaluation_daemon {
+/** Unit of all values sent over the socket. */
+using Word = std::uint64_t;
+
+/** Types of requests sent by the clients. */
+enum class Request : Word {
+    LOAD = 1,
+    SCORE = 2,
+};
+
+/** Status of the replies sent by the daemon. */
+enum class Status : Word {
+    OK = 0,
+    ERROR = 1,
+};
+
+/**
+ * Exception thrown when the other side closes the connection in the middle of a message.
+ */
+class ConnectionClosed : public std::runtime_error {
+public:
+    ConnectionClosed()
+        : std::runtime_error{"Connection closed"} {}
+};
+
+/**
+ * Buffered connection over a Unix domain socket.
+ *
+ * The connection owns the socket and closes it when destroyed.
+ */
+class Connection {
+public:
+    /**
+     * Construct a connection for the given connected socket.
+     *
+     * @param socket File descriptor of the socket.
+     */
+    explicit Connection(int socket)
+        : socket_(socket) {}
+
+    /**
+     * Connect to the daemon listening on the given socket path.
+     *
+     * @param socket_path Path of the daemon's socket.
+     */
+    static Connection connect(const std::string &socket_path);
+
+    Connection(const Connection &) = delete;
+    Connection &operator=(const Connection &) = delete;
+    Connection(Connection &&other) noexcept;
+    Connection &operator=(Connection &&other) noexcept;
+
+    /**
+     * Close the socket.
+     */
+    ~Connection();
+
+    /**
+     * Return the file descriptor of the socket.
+     */
+    int socket() const {
+        return socket_;
+    }
+
+    /**
+     * Read the next word, or return nothing if the other side closed the connection before sending it.
+     */
+    std::optional<Word> try_read();
+
+    /**
+     * Read the next word.
+     *
+     * Throws `ConnectionClosed` if the other side closed the connection.
+     */
+    Word read();
+
+    /**
+     * Read a string.
+     */
+    std::string read_string();
+
+    /**
+     * Write a word to the output buffer.
+     *
+     * @param word Value to write.
+     */
+    void write(Word word) {
+        output_.push_back(word);
+    }
+
+    /**
+     * Write a string to the output buffer.
+     *
+     * @param string String to write.
+     */
+    void write_string(std::string_view string);
+
+    /**
+     * Send the output buffer.
+     */
+    void flush();
+
+private:
+    /**
+     * Fill the input buffer with at least one more byte.
+     *
+     * Returns False if the other side closed the connection.
+     */
+    bool fill();
+
+    /** File descriptor of the socket, or -1 if it was moved from. */
+    int socket_;
+
+    /** Bytes received but not read yet are stored in `input_[input_begin_:input_end_]`. */
+    std::vector<std::byte> input_ = std::vector<std::byte>(1 << 16);
+    /** Position of the first byte not read yet. */
+    std::size_t input_begin_ = 0;
+    /** Position after the last received byte. */
+    std::size_t input_end_ = 0;
+
+    /** Words written but not sent yet. */
+    std::vector<Word> output_;
+};
+}
+
+#endif
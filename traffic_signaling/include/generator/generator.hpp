@@ -0,0 +1,177 @@
+#ifndef GENERATOR_GENERATOR_HPP
+#define GENERATOR_GENERATOR_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Generator of synthetic city plans in the input format of the competition.
+ *
+ * The generated city plans are used to test how the simulator scales to inputs larger than the bundled datasets.
+ */
+namespace generator {
+/** Structures of the generated street graphs. */
+enum class Topology {
+    /** Intersections on a grid connected to their neighbours, plus random streets. */
+    GRID,
+    /** Most of the streets lead to or from a few hub intersections. */
+    HUBS,
+};
+
+/** Distributions of the lengths of car paths. */
+enum class PathLengths {
+    /** Uniform distribution between the minimum and maximum path lengths. */
+    UNIFORM,
+    /** Geometric distribution with the given mean, truncated to the minimum and maximum path lengths. */
+    GEOMETRIC,
+};
+
+/**
+ * Parse the name of a topology, case-insensitively.
+ *
+ * @param name Name of the topology, either "grid" or "hubs".
+ */
+Topology parse_topology(std::string name);
+
+/**
+ * Parse the name of a path lengths distribution, case-insensitively.
+ *
+ * @param name Name of the distribution, either "uniform" or "geometric".
+ */
+PathLengths parse_path_lengths(std::string name);
+
+/** Parameters of a generated city plan. */
+struct Options {
+    /** Duration of the simulation in seconds. */
+    unsigned long duration = 1000;
+    /** Number of intersections. */
+    unsigned long intersections = 1000;
+    /** Number of streets; every intersection gets at least one incoming and one outgoing street. */
+    unsigned long streets = 4000;
+    /** Number of cars. */
+    unsigned long cars = 1000;
+    /** Bonus points for each car reaching its destination before the end of the simulation. */
+    unsigned long bonus = 1000;
+    /** Maximum time needed to drive through a street; the lengths are uniform between 1 and this value. */
+    unsigned long max_street_length = 50;
+    /** Minimum number of streets in the path of a car. */
+    unsigned long min_path_length = 2;
+    /** Maximum number of streets in the path of a car. */
+    unsigned long max_path_length = 100;
+    /** Mean number of streets in the path of a car, used only by the geometric distribution. */
+    unsigned long mean_path_length = 20;
+    /** Distribution of the lengths of car paths. */
+    PathLengths path_lengths = PathLengths::UNIFORM;
+    /** Structure of the street graph. */
+    Topology topology = Topology::GRID;
+    /** Random seed; the same options and seed always give the same city plan. */
+    unsigned long seed = 42;
+};
+
+/**
+ * Generator of one synthetic city plan.
+ *
+ * The street graph is built when constructing the generator. The cars are generated while writing
+ * and never stored, so city plans with paths much larger than the available memory can be written.
+ */
+class CityPlanGenerator {
+public:
+    /**
+     * Construct a generator and build the street graph.
+     *
+     * @param options Parameters of the generated city plan.
+     */
+    explicit CityPlanGenerator(const Options &options);
+
+    /**
+     * Write the city plan in the input format of the competition.
+     *
+     * Writing the same generator again gives the same output.
+     *
+     * @param output Stream to write the city plan to.
+     */
+    void write(std::ostream &output) const;
+
+private:
+    /** Street of the generated graph. */
+    struct Street {
+        /** ID of the intersection at the start of the street. */
+        unsigned long begin;
+        /** ID of the intersection at the end of the street. */
+        unsigned long end;
+        /** Time needed to drive through the street. */
+        unsigned long length;
+    };
+
+    /** Check that the options describe a valid city plan. */
+    void validate() const;
+
+    /**
+     * Add the street between the given intersections, unless it already exists or it would be a loop.
+     *
+     * Returns True if the street was added.
+     *
+     * @param begin ID of the intersection at the start of the street.
+     * @param end ID of the intersection at the end of the street.
+     */
+    bool add_street(unsigned long begin, unsigned long end);
+
+    /** Add streets between neighbouring intersections on a grid. */
+    void add_grid_streets();
+    /** Add streets leading to or from the hub intersections. */
+    void add_hub_streets();
+    /** Add streets between random intersections until the requested number of streets is reached. */
+    void add_random_streets();
+    /** Index the outgoing streets of every intersection. */
+    void index_outgoing_streets();
+
+    /**
+     * Draw the number of streets in the path of a car.
+     *
+     * @param random_engine Random engine used for the cars.
+     */
+    unsigned long path_length(std::mt19937_64 &random_engine) const;
+
+    /**
+     * Generate the path of a car as a vector of street IDs.
+     *
+     * @param random_engine Random engine used for the cars.
+     * @param used Marks of the streets used by the path, indexed by street IDs; all False on return.
+     * @param path Vector to store the path in.
+     */
+    void generate_path(
+        std::mt19937_64 &random_engine, std::vector<bool> &used, std::vector<unsigned long> &path
+    ) const;
+
+    /**
+     * Append the name of the street to the given string.
+     *
+     * @param street_id ID of the street.
+     * @param output String to append the name to.
+     */
+    void append_street_name(unsigned long street_id, std::string &output) const;
+
+    /** Parameters of the generated city plan. */
+    Options options_;
+    /** Random engine used to build the street graph. */
+    std::mt19937_64 random_engine_;
+
+    /** Streets of the graph indexed by street IDs. */
+    std::vector<Street> streets_;
+    /** Pairs of connected intersections, used to avoid duplicate streets. */
+    std::unordered_set<std::uint64_t> connections_;
+
+    /**
+     * Offsets of the outgoing streets of the intersections in `outgoing_streets_` indexed by intersection IDs.
+     */
+    std::vector<unsigned long> outgoing_offsets_;
+    /** IDs of the streets grouped by their starting intersections. */
+    std::vector<unsigned long> outgoing_streets_;
+};
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SIMULATION_ADAPTIVE_VARIANT_HPP
+#define SIMULATION_ADAPTIVE_VARIANT_HPP
+
+#include <utility>
+#include <vector>
+
+namespace simulation {
+/**
+ * Adaptive schedules built by one construction run of `Simulation::adaptive_variants`.
+ */
+struct AdaptiveVariant {
+    /** Index of the variant; variant 0 processes the cars in the order of their IDs. */
+    unsigned long variant{};
+    /** Score of the schedules. */
+    unsigned long score{};
+    /** Schedules of the non-trivial intersections in the format of `Simulation::non_trivial_schedules`. */
+    std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>> schedules;
+};
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SIMULATION_CACHE_LINE_HPP
+#define SIMULATION_CACHE_LINE_HPP
+
+#include <cstddef>
+
+namespace simulation {
+/** Size of a cache line assumed for padding the data of different threads. */
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef SIMULATION_CAR_HPP
 #define SIMULATION_CAR_HPP
 
+#include <concepts>
 #include <optional>
 
 #include "city_plan/car.hpp"
@@ -10,7 +11,10 @@ namespace simulation {
  * Car in the simulation.
  *
  * Contains the "dynamic" data and manipulates the car during the simulation.
+ *
+ * @tparam Index Unsigned integer type used to store indices and times of the car.
  */
+template<std::unsigned_integral Index>
 class Car {
 public:
     /**
@@ -25,7 +29,14 @@ public:
      * Return the ID of the street the car is currently on.
      */
     unsigned long current_street() const {
-        return data_.path()[path_index_].get().id();
+        return data_.street_ids()[path_index_];
+    }
+
+    /**
+     * Return the index of the street the car is currently on in its path.
+     */
+    Index path_index() const {
+        return path_index_;
     }
 
     /**
@@ -39,7 +50,7 @@ public:
      * Return True if the car is at the final street in its path.
      */
     bool final_destination() const {
-        return data_.path().size() - 1 == path_index_;
+        return data_.street_ids().size() - 1 == path_index_;
     }
 
     /**
@@ -57,21 +68,21 @@ public:
      * @param bonus Bonus for arriving before the end of the simulation.
      */
     void arrive(unsigned long arrival_time, unsigned long max_time, unsigned long bonus) {
-        arrival_time_ = arrival_time;
-        score_ = bonus + max_time - arrival_time;
+        arrival_time_ = static_cast<Index>(arrival_time);
+        score_ = static_cast<Index>(bonus + max_time - arrival_time);
     }
 
     /**
      * Return the time the car arrived at its destination.
      */
-    std::optional<unsigned long> arrival_time() const {
+    std::optional<Index> arrival_time() const {
         return arrival_time_;
     }
 
     /**
      * Return the score of the car.
      */
-    unsigned long score() const {
+    Index score() const {
         return score_;
     }
 
@@ -86,16 +97,34 @@ public:
         score_ = {};
     }
 
+    /**
+     * Restore the car to a state captured in a snapshot.
+     *
+     * @param path_index Index of the street the car is on in its path.
+     * @param arrival_time Time the car arrived at its destination, if it has arrived.
+     * @param max_time Duration of the simulation.
+     * @param bonus Bonus for arriving before the end of the simulation.
+     */
+    void restore(
+        unsigned long path_index, std::optional<unsigned long> arrival_time, unsigned long max_time, unsigned long bonus
+    ) {
+        reset();
+        path_index_ = static_cast<Index>(path_index);
+        if (arrival_time.has_value()) {
+            arrive(*arrival_time, max_time, bonus);
+        }
+    }
+
 private:
     /** "Static" information of the car from the city plan. */
     const city_plan::Car &data_;
 
     /** Index of the street the car is currently on in its path. */
-    unsigned long path_index_{};
+    Index path_index_{};
     /** Time the car arrived at its destination, if it has arrived. */
-    std::optional<unsigned long> arrival_time_;
+    std::optional<Index> arrival_time_;
     /** Score of the car after running the simulation. */
-    unsigned long score_{};
+    Index score_{};
 };
 }
 
@@ -0,0 +1,37 @@
+#ifndef SIMULATION_COMPARISON_HPP
+#define SIMULATION_COMPARISON_HPP
+
+#include <optional>
+#include <vector>
+
+namespace simulation {
+/**
+ * Car whose arrival differs between the runs of two sets of schedules.
+ */
+struct CarChange {
+    /** ID of the car. */
+    unsigned long car_id{};
+    /** Time the car arrived at its destination with the current schedules, if it has arrived. */
+    std::optional<unsigned long> arrival_time;
+    /** Time the car arrived at its destination with the other schedules, if it has arrived. */
+    std::optional<unsigned long> other_arrival_time;
+    /** Score of the car with the other schedules minus its score with the current schedules. */
+    long score_delta{};
+};
+
+/**
+ * Result of comparing the current schedules of a simulation with other schedules.
+ */
+struct Comparison {
+    /** Score of the current schedules. */
+    unsigned long score{};
+    /** Score of the other schedules. */
+    unsigned long other_score{};
+    /** Score of the other schedules minus the score of the current schedules. */
+    long score_delta{};
+    /** Cars whose arrival differs, ordered by car IDs. */
+    std::vector<CarChange> cars;
+};
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef SIMULATION_EVALUATION_POOL_HPP
+#define SIMULATION_EVALUATION_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "city_plan/city_plan.hpp"
+#include "simulation/cache_line.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simulation {
+/**
+ * Handle to a score calculated in the background by an `EvaluationPool`.
+ */
+class ScoreFuture {
+public:
+    /**
+     * Construct a handle for the given shared state.
+     *
+     * @param future Future of the score.
+     */
+    explicit ScoreFuture(std::shared_future<unsigned long> future)
+        : future_(std::move(future)) {}
+
+    /**
+     * Wait until the score is calculated and return it.
+     *
+     * If the calculation failed, the exception is rethrown.
+     */
+    unsigned long result() const {
+        return future_.get();
+    }
+
+    /**
+     * Return True if the score is already calculated.
+     */
+    bool done() const {
+        return future_.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }
+
+private:
+    /** Future of the score. */
+    std::shared_future<unsigned long> future_;
+};
+
+/**
+ * Pool of worker threads calculating scores of schedules in the background.
+ *
+ * Each worker owns its own replica of the simulation, so the schedules are scored in parallel
+ * while the caller keeps working (e.g. producing the next schedules to score).
+ * The replicas are cloned by the workers themselves, so their memory is first touched by the thread
+ * (and with pinning, the core) using it, which keeps it on the local NUMA node.
+ */
+class EvaluationPool {
+public:
+    /** Vector of `(order, times)` pairs, where each pair is a schedule for one non-trivial intersection. */
+    using Schedules = std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>>;
+
+    /**
+     * Construct an evaluation pool for the given city plan.
+     *
+     * Returns after all workers have created their replicas.
+     *
+     * @param city_plan City plan containing information from the input file.
+     * @param threads Number of worker threads, by default the number of hardware threads.
+     * @param cache Score cache shared by the replicas of the workers, or nullptr to disable caching.
+     * @param pin_threads If True, the workers are pinned to the CPUs the process may run on, one worker per CPU
+     * (round-robin if there are more workers than CPUs). Pinning is supported only on Linux and ignored elsewhere.
+     */
+    explicit EvaluationPool(
+        const city_plan::CityPlan &city_plan, unsigned long threads = default_threads(),
+        std::shared_ptr<ScoreCache> cache = nullptr, bool pin_threads = false
+    );
+
+    EvaluationPool(const EvaluationPool &) = delete;
+    EvaluationPool &operator=(const EvaluationPool &) = delete;
+
+    /**
+     * Stop the workers after all submitted jobs are scored.
+     */
+    ~EvaluationPool();
+
+    /**
+     * Submit schedules to be scored by one of the workers.
+     *
+     * The schedules are validated before they are submitted, see `validate_non_trivial_schedules()`,
+     * so `std::invalid_argument` is thrown here rather than on a worker.
+     *
+     * @param schedules Vector of `(order, times)` pairs, where each pair is a schedule for one intersection.
+     * @param relative_order If True, `order` must be a vector of street indices relative to each intersection.
+     * Otherwise, `order` must be a vector of street IDs.
+     */
+    ScoreFuture submit(Schedules &&schedules, bool relative_order = false);
+
+    /**
+     * Return the number of worker threads.
+     */
+    unsigned long threads() const {
+        return workers_.size();
+    }
+
+    /**
+     * Return True if every worker was pinned to a CPU.
+     *
+     * Pinning fails e.g. on platforms other than Linux, or when the CPU affinity can't be changed.
+     */
+    bool pinned() const {
+        return pinned_;
+    }
+
+    /**
+     * Return the number of jobs scored by each worker so far.
+     */
+    std::vector<unsigned long> scored() const;
+
+    /**
+     * Return the number of hardware threads, or 1 if it can't be determined.
+     */
+    static unsigned long default_threads() {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+private:
+    /** Schedules waiting to be scored. */
+    struct Job {
+        /** Schedules of the non-trivial intersections. */
+        Schedules schedules;
+        /** Whether the orders are relative to the intersections. */
+        bool relative_order;
+        /** Promise of the score. */
+        std::promise<unsigned long> promise;
+    };
+
+    /**
+     * State owned by one worker.
+     *
+     * Aligned to a cache line, so that the workers updating their own states don't invalidate
+     * each other's cache lines (false sharing).
+     */
+    struct alignas(CACHE_LINE_SIZE) WorkerState {
+        /** Replica of the simulation, cloned by the worker thread. */
+        std::optional<Simulation> simulation;
+        /** Number of jobs scored by the worker. */
+        std::atomic<unsigned long> scored{0};
+        /** Error thrown while creating the replica. */
+        std::exception_ptr error;
+        /** Whether the worker was pinned to a CPU. */
+        bool pinned = false;
+    };
+
+    /**
+     * Create the replica of the worker and score the submitted jobs until the pool is stopped.
+     *
+     * @param stop_token Token signalling that the pool is being destroyed.
+     * @param index Index of the worker.
+     * @param pin_thread If True, pin the worker to a CPU before creating the replica.
+     */
+    void work(std::stop_token stop_token, unsigned long index, bool pin_thread);
+
+    /**
+     * Score the submitted jobs until the pool is stopped.
+     *
+     * @param stop_token Token signalling that the pool is being destroyed.
+     * @param state State of the worker with its replica.
+     */
+    void score_jobs(std::stop_token stop_token, WorkerState &state);
+
+    /** City plan of the replicas, used to validate the submitted schedules. */
+    const city_plan::CityPlan &city_plan_;
+    /** Replica with the default schedules that the workers clone; it's never used for scoring. */
+    const Simulation template_;
+    /** States of the workers indexed by worker indices. */
+    std::vector<WorkerState> states_;
+    /** Whether the workers are pinned to CPUs. */
+    bool pinned_ = false;
+    /** Latch counted down by each worker after creating its replica. */
+    std::latch ready_;
+
+    /** Mutex guarding the job queue. */
+    std::mutex mutex_;
+    /** Condition variable signalling new jobs or stopping of the pool. */
+    std::condition_variable_any jobs_available_;
+    /** Jobs waiting for a free worker. */
+    std::deque<Job> jobs_;
+
+    /** Worker threads; declared last so that they are started after the other members are constructed. */
+    std::vector<std::jthread> workers_;
+};
+}
+
+#endif
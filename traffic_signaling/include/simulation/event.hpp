@@ -1,102 +1,114 @@
 #ifndef SIMULATION_EVENT_HPP
 #define SIMULATION_EVENT_HPP
 
-#include <functional>
-
-#include "simulation/street.hpp"
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace simulation {
 /**
- * Event in the simulation.
+ * Street event in the simulation.
+ *
+ * Represents the moment when a car on this street has the green light and moves to the next street.
+ *
+ * The event is a trivially copyable record because the event queue moves it on every push and pop.
+ * The time and the sequence number of the event are packed into a single key, so that events are ordered
+ * by the time and ties are broken by the sequence number using a single comparison.
  *
- * Serves as an abstract base class for events in the event queue.
+ * @tparam Index Unsigned integer type used to store the time, sequence number and street ID of the event.
  */
-class Event {
+template<std::unsigned_integral Index>
+class StreetEvent {
 public:
-    virtual ~Event() = default;
+    /**
+     * Construct a street event with a given time, sequence number and street.
+     *
+     * @param time Time of the event occurrence.
+     * @param sequence Sequence number of the event used to break ties between events occurring at the same time.
+     * @param street_id ID of the street the event is associated with.
+     */
+    StreetEvent(Index time, Index sequence, Index street_id)
+        : key_(make_key(time, sequence)), street_id_(street_id) {}
 
     /**
      * Return the time the event occurs.
      */
-    unsigned long time() const {
-        return time_;
+    Index time() const {
+        if constexpr (PACKED) {
+            return static_cast<Index>(key_ >> INDEX_BITS);
+        }
+        else {
+            return key_[0];
+        }
     }
 
     /**
-     * Return True if this event occurs before the other event.
+     * Return the sequence number of the event.
      */
-    bool operator<(const Event &other) const;
-    /**
-     * Return True if this event occurs after the other event.
-     */
-    bool operator>(const Event &other) const;
-
-    /** Type of the event. */
-    enum class Type {
-        STREET_EVENT_TYPE
-    };
+    Index sequence() const {
+        if constexpr (PACKED) {
+            return static_cast<Index>(key_);
+        }
+        else {
+            return key_[1];
+        }
+    }
 
     /**
-     * Return the type of the event.
-     *
-     * Used to determine the type of the event when processing it in the event queue.
+     * Return the ID of the street associated with this event.
      */
-    virtual Type event_type() const = 0;
+    Index street_id() const {
+        return street_id_;
+    }
 
-protected:
     /**
-     * Construct an event occurring at the given time.
-     *
-     * @param time Time of the event occurrence.
+     * Return True if this event occurs before the other event.
      */
-    explicit Event(unsigned long time);
+    bool operator<(const StreetEvent &other) const {
+        return key_ < other.key_;
+    }
 
     /**
-     * Counter for unique event IDs.
-     *
-     * Used to break ties in the event queue when two events occur at the same time.
+     * Return True if this event occurs after the other event.
      */
-    static size_t counter_;
-    /** Unique ID of the event. */
-    size_t counter_id_;
-    /** Time of the event occurrence. */
-    unsigned long time_;
-};
+    bool operator>(const StreetEvent &other) const {
+        return key_ > other.key_;
+    }
 
-/**
- * Street event in the simulation.
- *
- * Represents the moment when a car on this street has the green light and moves to the next street.
- */
-class StreetEvent : public Event {
-public:
-    /**
-     * Construct a street event with a given time and street.
-     *
-     * @param time Time of the event in occurrence.
-     * @param street Street the event is associated with.
-     */
-    StreetEvent(unsigned long time, Street &street)
-        : Event(time), street_(street) {}
+private:
+    /** Number of bits of the `Index` type. */
+    static constexpr auto INDEX_BITS = std::numeric_limits<Index>::digits;
+    /** Whether both the time and the sequence number fit into a single 64-bit key. */
+    static constexpr bool PACKED = 2 * INDEX_BITS <= std::numeric_limits<std::uint64_t>::digits;
 
     /**
-     * Return the type of the event.
+     * Key of the event; a 64-bit integer with the time in the upper half if both values fit,
+     * or a `(time, sequence)` array compared lexicographically otherwise.
      */
-    Type event_type() const override {
-        return Type::STREET_EVENT_TYPE;
-    }
+    using Key = std::conditional_t<PACKED, std::uint64_t, std::array<Index, 2>>;
 
     /**
-     * Return the street associated with this event.
+     * Pack the time and the sequence number into the key of the event.
      */
-    Street &street() const {
-        return street_;
+    static Key make_key(Index time, Index sequence) {
+        if constexpr (PACKED) {
+            return (static_cast<std::uint64_t>(time) << INDEX_BITS) | sequence;
+        }
+        else {
+            return {time, sequence};
+        }
     }
 
-private:
-    /** Street of this event. */
-    std::reference_wrapper<Street> street_;
+    /** Time and sequence number of the event. */
+    Key key_;
+    /** ID of the street of this event. */
+    Index street_id_;
 };
+
+static_assert(std::is_trivially_copyable_v<StreetEvent<std::uint32_t>>);
+static_assert(sizeof(StreetEvent<std::uint32_t>) == 16);
 }
 
 #endif
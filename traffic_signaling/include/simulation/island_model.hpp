@@ -0,0 +1,106 @@
+#ifndef SIMULATION_ISLAND_MODEL_HPP
+#define SIMULATION_ISLAND_MODEL_HPP
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "city_plan/city_plan.hpp"
+#include "simulation/score_cache.hpp"
+
+namespace simulation {
+/**
+ * Parameters of the island model genetic algorithm.
+ *
+ * The defaults are the defaults of the genetic algorithm of the optimizer.
+ */
+struct IslandParameters {
+    /** Number of islands, each evolved by its own thread. */
+    unsigned long islands = city_plan::CityPlan::default_threads();
+    /** Number of individuals of each island. */
+    unsigned long population = 100;
+    /** Maximum number of generations of each island. */
+    unsigned long generations = 100;
+    /** Probability of mating each pair of individuals. */
+    double crossover = 0.6;
+    /** Probability of mutating each individual. */
+    double mutation = 0.4;
+    /** Probability of mutating each street of a mutated individual (its position and its time). */
+    double mutation_indpb = 0.01;
+    /** Largest green light time produced by mutations; 0 means the duration of the city plan. */
+    unsigned long max_time = 0;
+    /** Fraction of the best individuals passed to the next generation unchanged. */
+    double elitism = 0.05;
+    /** Number of individuals in each tournament. */
+    unsigned long tournsize = 3;
+    /** Number of generations between two migrations of an island. */
+    unsigned long migration_interval = 10;
+    /** Number of the best individuals sent to the next island in each migration. */
+    unsigned long migrants = 2;
+    /** Seed of the random engines of the islands. */
+    unsigned long seed = 42;
+    /** Score at which all islands stop, e.g. an upper bound of the score. */
+    std::optional<unsigned long> target;
+};
+
+/**
+ * Statistics of one generation of one island.
+ */
+struct IslandGeneration {
+    /** Index of the island. */
+    unsigned long island{};
+    /** Generation number; generation 0 is the initial population. */
+    unsigned long generation{};
+    /** Number of individuals evaluated in the generation. */
+    unsigned long evaluations{};
+    /** Highest score in the population. */
+    unsigned long max_score{};
+    /** Average score of the population. */
+    double average_score{};
+};
+
+/**
+ * Result of the island model genetic algorithm.
+ */
+struct IslandResult {
+    /** Schedules of the non-trivial intersections of the best individual, with relative orders. */
+    std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>> schedules;
+    /** Score of the best individual. */
+    unsigned long score{};
+    /** Statistics of all generations of all islands, ordered by generations and islands. */
+    std::vector<IslandGeneration> history;
+    /** Number of migrants received by the islands. */
+    unsigned long migrations{};
+};
+
+/**
+ * Run a genetic algorithm with one population per island, each island evolved by its own thread
+ * against its own simulation replica.
+ *
+ * Each generation uses the same operators as `operators.py` of the optimizer: tournament selection
+ * with elitism, ordered crossover of the orders and two-point crossover of the times of each schedule,
+ * and mutation shuffling the positions of the streets and changing their times by one second.
+ * Only the changed individuals are evaluated.
+ *
+ * The islands form a ring: every `migration_interval` generations, an island sends copies of its best
+ * individuals to a lock-free queue of the next island, which replaces its worst individuals with them
+ * at the start of its next generation. The islands never wait for each other, so with more than one
+ * island the result also depends on the timing of the threads.
+ *
+ * Throws `std::invalid_argument` if a parameter is zero or an initial individual is invalid,
+ * see `validate_non_trivial_schedules()`.
+ *
+ * @param city_plan City plan containing information from the input file.
+ * @param initial Initial individuals with relative orders; the islands take them in turns.
+ * @param parameters Parameters of the algorithm.
+ * @param cache Score cache shared by the replicas of the islands, or nullptr to disable caching.
+ */
+IslandResult island_genetic_algorithm(
+    const city_plan::CityPlan &city_plan,
+    const std::vector<std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>>> &initial,
+    const IslandParameters &parameters, std::shared_ptr<ScoreCache> cache = nullptr
+);
+}
+
+#endif
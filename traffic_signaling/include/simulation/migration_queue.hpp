@@ -0,0 +1,78 @@
+#ifndef SIMULATION_MIGRATION_QUEUE_HPP
+#define SIMULATION_MIGRATION_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "simulation/cache_line.hpp"
+
+namespace simulation {
+/**
+ * Bounded lock-free queue passing values from one producer thread to one consumer thread.
+ *
+ * The queue is a ring buffer with one slot left empty to tell a full queue from an empty one.
+ * The producer only writes the tail and the consumer only writes the head, so neither of them ever waits.
+ */
+template<class T>
+class MigrationQueue {
+public:
+    /**
+     * Construct an empty queue.
+     *
+     * @param capacity Maximum number of values in the queue, at least 1.
+     */
+    explicit MigrationQueue(std::size_t capacity) : slots_(capacity + 1) {
+        if (capacity == 0) {
+            throw std::invalid_argument{"Queue capacity must be positive"};
+        }
+    }
+
+    MigrationQueue(const MigrationQueue &) = delete;
+    MigrationQueue &operator=(const MigrationQueue &) = delete;
+
+    /**
+     * Append the value and return True, or return False without moving it if the queue is full.
+     *
+     * Must only be called by the producer thread.
+     */
+    bool push(T &&value) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        auto next = (tail + 1) % slots_.size();
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove and return the oldest value, or return nothing if the queue is empty.
+     *
+     * Must only be called by the consumer thread.
+     */
+    std::optional<T> pop() {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return {};
+        }
+        std::optional<T> value{std::move(slots_[head])};
+        head_.store((head + 1) % slots_.size(), std::memory_order_release);
+        return value;
+    }
+
+private:
+    /** Slots of the ring buffer. */
+    std::vector<T> slots_;
+    /** Index of the oldest value, written by the consumer. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+    /** Index of the next free slot, written by the producer. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+};
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef SIMULATION_RUN_STATE_HPP
+#define SIMULATION_RUN_STATE_HPP
+
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <vector>
+
+#include "city_plan/city_plan.hpp"
+#include "simulation/car.hpp"
+#include "simulation/event.hpp"
+#include "simulation/street.hpp"
+
+namespace simulation {
+/**
+ * "Dynamic" state of a simulation run.
+ *
+ * Contains the streets, cars and events of the run. Car IDs, times and sequence numbers are stored
+ * using the `Index` type, so that the state of city plans that fit in 32 bits takes half the memory.
+ *
+ * @tparam Index Unsigned integer type used to store indices and times of the run.
+ */
+template<std::unsigned_integral Index>
+struct RunState {
+    /**
+     * Construct the run state for the given city plan.
+     *
+     * @param city_plan City plan containing information from the input file.
+     */
+    explicit RunState(const city_plan::CityPlan &city_plan) {
+        streets.reserve(city_plan.streets().size());
+        cars.reserve(city_plan.cars().size());
+
+        for (auto &&s: city_plan.streets()) {
+            streets.emplace_back(s);
+        }
+        for (auto &&c: city_plan.cars()) {
+            cars.emplace_back(c);
+        }
+
+        // Counting sort of the cars by their starting streets,
+        // the cars of each street stay in the order of their IDs
+        starting_offsets.assign(streets.size() + 1, 0);
+        for (auto &&c: city_plan.cars()) {
+            ++starting_offsets[c.street_ids().front() + 1];
+        }
+        std::partial_sum(starting_offsets.begin(), starting_offsets.end(), starting_offsets.begin());
+        starting_car_ids.resize(cars.size());
+        auto positions = starting_offsets;
+        for (auto &&c: city_plan.cars()) {
+            starting_car_ids[positions[c.street_ids().front()]++] = static_cast<Index>(c.id());
+        }
+    }
+
+    /**
+     * Return True if all values of a run for the given city plan can be stored using the `Index` type.
+     *
+     * Times are capped at the end of the simulation, and the number of events in one run
+     * is bounded by the number of non-final streets in the paths of all cars.
+     *
+     * @param city_plan City plan containing information from the input file.
+     */
+    static bool fits(const city_plan::CityPlan &city_plan) {
+        constexpr unsigned long max = std::numeric_limits<Index>::max();
+        unsigned long events = 0;
+        for (auto &&car: city_plan.cars()) {
+            events += static_cast<unsigned long>(car.street_ids().size()) - 1;
+        }
+        return city_plan.cars().size() <= max
+            && city_plan.streets().size() <= max
+            && city_plan.duration() + city_plan.bonus() < max
+            && events <= max;
+    }
+
+    /**
+     * Return the IDs of the cars starting at the end of the given street, in ascending order.
+     *
+     * @param street_id ID of the street.
+     */
+    std::span<const Index> starting_cars(unsigned long street_id) const {
+        return std::span{starting_car_ids}.subspan(
+            starting_offsets[street_id], starting_offsets[street_id + 1] - starting_offsets[street_id]
+        );
+    }
+
+    /**
+     * Reset the run state to its initial state.
+     */
+    void reset() {
+        sequence = {};
+        event_queue = {};
+        for (auto &&s: streets) {
+            s.reset();
+        }
+        for (auto &&c: cars) {
+            c.reset();
+        }
+        queue_stats = {};
+    }
+
+    /** Streets in the simulation. */
+    std::vector<Street<Index>> streets;
+    /** Cars in the simulation. */
+    std::vector<Car<Index>> cars;
+
+    /**
+     * Offsets of the starting cars of the streets in `starting_car_ids` indexed by street IDs.
+     *
+     * The cars starting on street `i` are stored in `starting_car_ids[starting_offsets[i]:starting_offsets[i + 1]]`.
+     */
+    std::vector<unsigned long> starting_offsets;
+    /** IDs of the cars grouped by their starting streets. */
+    std::vector<Index> starting_car_ids;
+
+    /**
+     * Event queue for the simulation, containing `StreetEvent` objects.
+     */
+    std::priority_queue<StreetEvent<Index>, std::vector<StreetEvent<Index>>, std::greater<>> event_queue;
+
+    /** Sequence number of the next event. */
+    Index sequence{};
+
+    /**
+     * Statistics of the street queues indexed by street IDs, or empty if the run doesn't collect them.
+     *
+     * The cars still waiting are not counted as waiting yet. The statistics are only collected by the runs
+     * of `Simulation::queue_stats()`, so the other runs don't pay for them.
+     */
+    std::vector<QueueStats> queue_stats;
+};
+}
+
+#endif
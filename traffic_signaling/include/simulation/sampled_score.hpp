@@ -0,0 +1,24 @@
+#ifndef SIMULATION_SAMPLED_SCORE_HPP
+#define SIMULATION_SAMPLED_SCORE_HPP
+
+namespace simulation {
+/**
+ * Score extrapolated from a run of a sample of the cars, see `Simulation::sampled_score`.
+ */
+struct SampledScore {
+    /** Estimate of the score of all cars. */
+    unsigned long estimate{};
+    /**
+     * Standard error of the estimate due to the choice of the cars.
+     *
+     * It doesn't account for the bias caused by the queues being shorter than with all cars.
+     */
+    double error{};
+    /** Score of the sampled cars. */
+    unsigned long score{};
+    /** Number of sampled cars. */
+    unsigned long cars{};
+};
+}
+
+#endif
@@ -1,12 +1,14 @@
 #ifndef SIMULATION_SCHEDULE_HPP
 #define SIMULATION_SCHEDULE_HPP
 
+#include <cstdint>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 #include <ranges>
 #include <limits>
 #include <random>
+#include <span>
 
 #include "city_plan/intersection.hpp"
 
@@ -37,6 +39,13 @@ public:
         std::vector<unsigned long> &&order, std::vector<unsigned long> &&times, bool relative_order = false
     );
 
+    /**
+     * Return the ID of the intersection of the schedule.
+     */
+    unsigned long intersection_id() const {
+        return intersection_.id();
+    }
+
     /**
      * Return the number of streets in the schedule.
      */
@@ -67,6 +76,17 @@ public:
         return times_;
     }
 
+    /**
+     * Return the 64-bit hash of the schedule.
+     *
+     * The hash is the XOR of the hashes of the `(position, street ID, time)` slots of the schedule,
+     * so the hashes of several schedules can be combined and updated using XOR as well.
+     * It is updated whenever the schedule changes. Empty schedules have the hash 0.
+     */
+    std::uint64_t hash() const {
+        return hash_;
+    }
+
     /**
      * Return the order of streets in the schedule.
      *
@@ -105,6 +125,18 @@ public:
      */
     void set(std::vector<unsigned long> &&order, std::vector<unsigned long> &&times, bool relative_order = false);
 
+    /**
+     * Set the schedule by copying the given order and times.
+     *
+     * Unlike `set`, the memory already allocated by the schedule is reused.
+     *
+     * @param order Order of streets in the schedule.
+     * @param times Green light times for each street in the order.
+     * @param relative_order If True, `order` must contain street indices relative to the intersection.
+     * Otherwise, `order` must contain street IDs.
+     */
+    void assign(std::span<const unsigned long> order, std::span<const unsigned long> times, bool relative_order = false);
+
     /**
      * Set the schedule using the given order and times initialization options.
      *
@@ -116,7 +148,8 @@ public:
     /**
      * Reset the schedule to its initial state.
      *
-     * This method is used for performance reasons to avoid frequent reallocation.
+     * This method is used for performance reasons to avoid frequent reallocation;
+     * the memory allocated for the order, times and green lights is kept.
      */
     void reset();
 
@@ -140,7 +173,12 @@ public:
      */
     std::optional<unsigned long> next_green(unsigned long street_id, unsigned long time);
 
-    /** Helper function to fill in the missing streets when using adaptive order option. */
+    /**
+     * Helper function to fill in the missing streets when using adaptive order option.
+     *
+     * Afterwards, the slots are merged into the final order and times; the seconds left unused
+     * extend the green light of the preceding street (or the following one at the start of the cycle).
+     */
     void fill_missing_streets();
 
     /* Default divisor for the scaled times option. */
@@ -149,17 +187,64 @@ public:
 private:
     using TimeInterval = std::ranges::iota_view<unsigned long, unsigned long>;
 
-    /** Initialize the adaptive order option. */
-    void set_adaptive();
-    /** Add a not yet scheduled street to the schedule when using adaptive order option. */
+    /**
+     * Compute the green light intervals, cycle duration and hash from the order and times.
+     *
+     * @param relative_order If True, the order contains street indices relative to the intersection
+     * and it's converted to street IDs first.
+     */
+    void index_green_lights(bool relative_order);
+
+    /**
+     * Initialize the adaptive order option.
+     *
+     * The cycle has one second for every second of the initial times of the streets; each second is
+     * a slot which is assigned to the street whose car reaches the intersection first.
+     *
+     * @param times_type Times initialization giving the widths of the slots of the streets.
+     */
+    void set_adaptive(Times times_type);
+    /**
+     * Add a not yet scheduled street to the schedule when using adaptive order option.
+     *
+     * The street gets as many consecutive slots as its initial time, starting at the first unused slot
+     * at or after the given time which is followed by enough unused slots before the end of the cycle.
+     * If there is no such gap, it gets the unused slots following the first unused one.
+     */
     void add_street_adaptive(unsigned long street_id, unsigned long time);
+    /** Assign the slots from `begin` to `end` to the street when using adaptive order option. */
+    void use_slots(unsigned long street_id, unsigned long begin, unsigned long end);
+
+    /**
+     * Return the initial green light time of the street.
+     *
+     * @param street_id ID of the street.
+     * @param times_type Times initialization to use.
+     */
+    unsigned long initial_time(unsigned long street_id, Times times_type) const;
+
+    /**
+     * Return the hash of one slot of the schedule.
+     *
+     * The slot hashes play the role of the random keys of Zobrist hashing, but they are computed
+     * by mixing the values instead of being stored in a table, because the times are not bounded.
+     *
+     * @param position Position of the street in the order.
+     * @param street_id ID of the street.
+     * @param time Green light time of the street.
+     */
+    std::uint64_t slot_hash(unsigned long position, unsigned long street_id, unsigned long time) const;
 
     /** Intersection for which this schedule is. */
     const city_plan::Intersection &intersection_;
     /** Whether the schedule uses the adaptive order option. */
     bool adaptive_{};
+    /** Times initialization of the adaptive order option. */
+    Times adaptive_times_{};
     /** The cycle duration of this schedule in seconds. */
     unsigned long total_duration_{};
+    /** Hash of the schedule, see `hash()`. */
+    std::uint64_t hash_{};
 
     /** Order of streets in the schedule (streets are represented by their IDs). */
     std::vector<unsigned long> order_;
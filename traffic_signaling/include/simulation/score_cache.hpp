@@ -0,0 +1,134 @@
+#ifndef SIMULATION_SCORE_CACHE_HPP
+#define SIMULATION_SCORE_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace simulation {
+/**
+ * Bounded cache of scores indexed by hashes of schedules.
+ *
+ * The cache can be shared by several simulations of the same city plan running on different threads.
+ * It is split into shards guarded by their own mutexes, and each shard evicts its entries
+ * using the CLOCK algorithm (an approximation of LRU): an entry used since the clock hand last passed it
+ * gets a second chance, otherwise it is replaced.
+ *
+ * Because the keys are 64-bit hashes, two different schedules could in theory share a key,
+ * but the probability of such collision is negligible.
+ */
+class ScoreCache {
+public:
+    /**
+     * Construct an empty score cache.
+     *
+     * @param capacity Maximum number of scores kept in the cache.
+     */
+    explicit ScoreCache(unsigned long capacity = DEFAULT_CAPACITY);
+
+    ScoreCache(const ScoreCache &) = delete;
+    ScoreCache &operator=(const ScoreCache &) = delete;
+
+    /**
+     * Return the score cached for the given key, if any.
+     *
+     * Every call counts as either a hit or a miss.
+     *
+     * @param key Hash of the schedules.
+     */
+    std::optional<unsigned long> find(std::uint64_t key);
+
+    /**
+     * Add the score for the given key to the cache, possibly evicting another entry.
+     *
+     * @param key Hash of the schedules.
+     * @param score Score of the schedules.
+     */
+    void insert(std::uint64_t key, unsigned long score);
+
+    /**
+     * Remove all entries from the cache and reset the hit and miss counters.
+     */
+    void clear();
+
+    /**
+     * Return the number of lookups that found a score.
+     */
+    unsigned long hits() const {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Return the number of lookups that didn't find a score.
+     */
+    unsigned long misses() const {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Return the number of scores in the cache.
+     */
+    unsigned long size() const;
+
+    /**
+     * Return the maximum number of scores kept in the cache.
+     */
+    unsigned long capacity() const {
+        return capacity_;
+    }
+
+    /** Default maximum number of scores kept in the cache. */
+    static constexpr auto DEFAULT_CAPACITY = 1UL << 16;
+
+private:
+    /** Cached score. */
+    struct Entry {
+        /** Hash of the schedules. */
+        std::uint64_t key;
+        /** Score of the schedules. */
+        unsigned long score;
+        /** Whether the entry was used since the clock hand last passed it. */
+        bool referenced;
+    };
+
+    /** Independently locked part of the cache. */
+    struct Shard {
+        /** Mutex guarding the shard. */
+        mutable std::mutex mutex;
+        /** Maximum number of entries in the shard. */
+        unsigned long capacity{};
+        /** Entries arranged in a circle traversed by the clock hand. */
+        std::vector<Entry> entries;
+        /** Positions of the entries indexed by their keys. */
+        std::unordered_map<std::uint64_t, unsigned long> positions;
+        /** Position of the clock hand in `entries`. */
+        unsigned long hand{};
+    };
+
+    /**
+     * Return the shard containing the given key.
+     *
+     * @param key Hash of the schedules.
+     */
+    Shard &shard(std::uint64_t key) {
+        return shards_[key % shards_.size()];
+    }
+
+    /** Maximum number of shards; smaller caches use one shard per entry. */
+    static constexpr auto MAX_SHARDS = 16UL;
+
+    /** Maximum number of scores kept in the cache. */
+    unsigned long capacity_;
+    /** Shards of the cache. */
+    std::vector<Shard> shards_;
+    /** Number of lookups that found a score. */
+    std::atomic<unsigned long> hits_{};
+    /** Number of lookups that didn't find a score. */
+    std::atomic<unsigned long> misses_{};
+};
+}
+
+#endif
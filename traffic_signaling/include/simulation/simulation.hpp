@@ -1,19 +1,27 @@
 #ifndef SIMULATION_SIMULATION_HPP
 #define SIMULATION_SIMULATION_HPP
 
+#include <cstdint>
 #include <functional>
 #include <locale>
-#include <queue>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "city_plan/city_plan.hpp"
+#include "simulation/adaptive_variant.hpp"
 #include "simulation/car.hpp"
-#include "simulation/event.hpp"
+#include "simulation/comparison.hpp"
+#include "simulation/run_state.hpp"
+#include "simulation/sampled_score.hpp"
 #include "simulation/schedule.hpp"
-#include "simulation/street.hpp"
+#include "simulation/score_cache.hpp"
+#include "simulation/snapshot.hpp"
+#include "simulation/trace.hpp"
 
 namespace simulation {
 /**
@@ -21,6 +29,14 @@ namespace simulation {
  */
 class Simulation {
 public:
+    /** Event scheduling engines of the simulation. */
+    enum class Engine {
+        /** Every car waiting at a traffic light has its own event in the event queue. */
+        CAR,
+        /** Only the first car waiting on each street has an event in the event queue. */
+        STREET,
+    };
+
     /**
      * Construct a simulation object for the given city plan.
      *
@@ -45,12 +61,40 @@ public:
     /**
      * Create schedules for all used intersections and used streets.
      *
+     * Adaptive order assigns the slots of the schedules to the streets in the order their first cars
+     * reach the intersections while running the simulation. With scaled times, each street gets a slot
+     * as long as its scaled time instead of one second.
+     *
      * @param order Initialization option for the order of streets in the schedules.
      * @param times Initialization option for the green light times in the schedules.
      * @param divisor Divisor for the scaled times option.
      */
     void create_schedules(std::string order, std::string times, unsigned long divisor = Schedule::DEFAULT_DIVISOR);
 
+    /**
+     * Create adaptive schedules from several construction runs on multiple threads and keep the best ones.
+     *
+     * Variant 0 is the same as `create_schedules("adaptive", times, divisor)`. The other variants add
+     * the cars to their starting streets in random orders, which changes the order in which streets
+     * reaching an intersection at the same time get their slots. Each variant is built on its own copy
+     * of the simulation, and the random order of each variant only depends on the seed and its index.
+     * The schedules of the best variant are set as the current schedules.
+     *
+     * @param variants Number of variants, at least 1.
+     * @param times Initialization option for the green light times in the schedules.
+     * @param divisor Divisor for the scaled times option.
+     * @param seed Seed of the random car orders.
+     * @param threads Maximum number of threads building the variants.
+     * @param relative_order If True, the orders of the returned schedules contain street indices relative
+     * to each intersection. Otherwise, they contain street IDs.
+     * @return All variants ordered from the highest score, ties in the order of the variants.
+     */
+    std::vector<AdaptiveVariant> adaptive_variants(
+        unsigned long variants, const std::string &times = "default",
+        unsigned long divisor = Schedule::DEFAULT_DIVISOR, unsigned long seed = 0,
+        unsigned long threads = city_plan::CityPlan::default_threads(), bool relative_order = false
+    );
+
     /**
      * Create default schedules.
      *
@@ -90,17 +134,168 @@ public:
         create_schedules("default", "scaled", divisor);
     }
 
+    /**
+     * Set the event scheduling engine used to run the simulation.
+     *
+     * The "car" engine keeps an event for every car waiting at a traffic light. The "street" engine keeps
+     * at most one event per street and computes the green light of the next car when the previous one leaves,
+     * which keeps the event queue small when long queues form. Both engines give the same scores.
+     *
+     * @param engine Name of the engine, either "car" or "street".
+     */
+    void set_engine(std::string engine);
+
+    /**
+     * Return the name of the event scheduling engine used to run the simulation.
+     */
+    std::string engine() const {
+        return engine_ == Engine::STREET ? "street" : "car";
+    }
+
+    /**
+     * Set the cache of scores used by `score()`.
+     *
+     * The cache can be shared by several simulations of the same city plan, including simulations
+     * running on other threads, but it must not be shared with simulations of other city plans.
+     *
+     * @param cache Score cache, or nullptr to disable caching.
+     */
+    void set_score_cache(std::shared_ptr<ScoreCache> cache) {
+        score_cache_ = std::move(cache);
+    }
+
+    /**
+     * Return the cache of scores used by `score()`, or nullptr if there is none.
+     */
+    const std::shared_ptr<ScoreCache> &score_cache() const {
+        return score_cache_;
+    }
+
+    /**
+     * Return the 64-bit hash of the current schedules.
+     *
+     * The hash is the XOR of the hashes of all schedules, and it is updated incrementally
+     * whenever some of the schedules change.
+     */
+    std::uint64_t schedules_hash() const {
+        return schedules_hash_;
+    }
+
     /**
      * Calculate the score for the current setting of schedules.
      *
-     * This method runs the simulation.
+     * This method runs the simulation. If a score cache is set and it already contains the score
+     * of the current schedules, the cached score is returned without running the simulation. The run state
+     * then still belongs to the previous run, so the methods reporting it run the simulation again.
      */
     unsigned long score();
 
+    /**
+     * Run the simulation only until the given horizon and return an estimate of the full score.
+     *
+     * The estimate is the score of the cars whose last traffic light is passed before the horizon, plus
+     * partial credit for the cars still on their way: each of them is expected to reach its destination
+     * after the free-flow duration of its remaining streets, waiting at each of its remaining traffic lights
+     * as long as the cars waited on average per traffic light before the horizon. The cars expected after
+     * the end of the simulation get no credit. The runtime grows with the horizon, and from the duration
+     * of the simulation on, the estimate is the exact score.
+     *
+     * Unlike `score()`, the estimate isn't cached, but the exact score is returned if the cache contains it.
+     *
+     * @param horizon Time until which the simulation is run.
+     */
+    unsigned long score(unsigned long horizon);
+
+    /**
+     * Select a deterministic stratified sample of the cars for `sampled_score()`.
+     *
+     * The cars are split into strata of equal sizes by the free-flow durations of their paths. Ordered by
+     * their strata and then by the intersections they start at, every `1 / fraction`-th car is sampled from
+     * a random offset, so every stratum and every part of the city is represented in proportion to its cars.
+     * The sample only depends on the fraction and the seed.
+     *
+     * Throws `std::invalid_argument` if the fraction is not in (0, 1].
+     *
+     * @param fraction Fraction of the cars to sample.
+     * @param seed Seed of the random offset.
+     */
+    void set_car_sample(double fraction, unsigned long seed = 0);
+
+    /**
+     * Remove the sample of the cars.
+     */
+    void clear_car_sample();
+
+    /**
+     * Return the IDs of the sampled cars in ascending order, or an empty vector if no sample is set.
+     */
+    std::vector<unsigned long> car_sample() const;
+
+    /**
+     * Run the simulation with only the sampled cars and extrapolate the score of all cars.
+     *
+     * The other cars never enter the streets. The estimate scales the score of the sampled cars of each stratum
+     * by the size of the stratum. Fewer cars form shorter queues, so the estimate is biased upwards
+     * on congested city plans; the reported error only covers the choice of the cars.
+     * The score cache is bypassed, because the cached scores are the scores of all cars.
+     *
+     * Throws `std::runtime_error` if no sample is set, see `set_car_sample()`.
+     */
+    SampledScore sampled_score();
+
+    /**
+     * Run the simulation while recording every car movement to a binary event trace, and return the score.
+     *
+     * Each time a car gets the green light, a `PASS` record with the car, the street and the times of its arrival
+     * at the traffic light and of the green light is written. The cars still waiting at the end of the run are
+     * written as `WAITING` records. The score cache is bypassed, so the simulation is always run.
+     *
+     * Throws `std::runtime_error` if the trace file can't be written.
+     *
+     * @param filename Path of the trace file, see `TraceWriter` for its format.
+     */
+    unsigned long trace(const std::string &filename);
+
+    /**
+     * Run the simulation until the given time and capture its state.
+     *
+     * All events occurring before `time` are processed using the current schedules.
+     *
+     * @param time Time at which to pause the run.
+     */
+    Snapshot snapshot(unsigned long time);
+
+    /**
+     * Resume the run captured in the snapshot and return the final score.
+     *
+     * The current schedules are applied from the snapshot time onwards. Resuming with the same schedules
+     * that were used to create the snapshot gives the same score as `score()`.
+     *
+     * @param snapshot Snapshot of a simulation of the same city plan.
+     */
+    unsigned long resume(const Snapshot &snapshot);
+
+    /**
+     * Find the best cyclic rotation of the schedule of the given intersection and apply it.
+     *
+     * Rotating the order (and the times with it) shifts when each street's green light starts within the cycle.
+     * The run of the current schedules is paused when its first car reaches the intersection, and every rotation
+     * is evaluated by resuming it, so the part of the run before that time is simulated only once. On ties,
+     * the smallest rotation is kept; if it's the original one, the intersection isn't marked as dirty.
+     *
+     * Returns a `(rotation, score)` pair, where rotation `r` means the schedule starts with the street
+     * at index `r` of the original order.
+     *
+     * @param intersection_id ID of the intersection with a schedule.
+     */
+    std::pair<unsigned long, unsigned long> optimize_rotation(unsigned long intersection_id);
+
     /**
      * Print a summary of the simulation statistics.
+     *
+     * The simulation is run first, unless the last complete run was a run of the current schedules.
      */
-    void summary() const;
+    void summary();
 
     /**
      * Return the current schedules as a map indexed by intersection IDs.
@@ -126,13 +321,98 @@ public:
      * @param relative_order If True, `order` must be a vector of street indices relative to each intersection.
      * Otherwise, `order` must be a vector of street IDs.
      *
-     * This method assumes the input is valid and performs no validation.
+     * This method assumes the input is valid and performs no validation, see `validate_non_trivial_schedules()`.
      */
     void set_non_trivial_schedules(
         std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>> &&schedules,
         bool relative_order = false
     );
 
+    /**
+     * Set the schedules of the given non-trivial intersections, leaving the other schedules untouched.
+     *
+     * The memory of the updated schedules is reused, so updating a few intersections is much cheaper
+     * than setting all non-trivial schedules. Schedules set to the same order and times are not marked
+     * as changed. All schedules are validated before any of them is applied, so the schedules are left
+     * untouched if `std::invalid_argument` is thrown.
+     *
+     * @param indices Indices of the intersections in the non-trivial intersections of the city plan
+     * (i.e. the same indices as in `non_trivial_schedules`).
+     * @param orders Orders of streets of the updated schedules.
+     * @param times Green light times of the updated schedules.
+     * @param relative_order If True, `orders` must contain street indices relative to each intersection.
+     * Otherwise, `orders` must contain street IDs.
+     */
+    void update_schedules(
+        const std::vector<unsigned long> &indices, const std::vector<std::vector<unsigned long>> &orders,
+        const std::vector<std::vector<unsigned long>> &times, bool relative_order = false
+    );
+
+    /**
+     * Compare the current schedules with schedules that differ in the given non-trivial intersections.
+     *
+     * Returns the score delta and the cars whose arrival changed. The run of the current schedules captures
+     * a few snapshots until the latest time the first car can reach a non-trivial intersection. The other
+     * schedules don't affect the run before the first car can reach any of the given intersections, so
+     * the run of the other schedules is resumed from the latest snapshot before that time. The arrivals
+     * and the snapshots of the current schedules are kept from the previous comparison if the schedules
+     * didn't change since then, so comparing several candidates with the same schedules runs only
+     * the part of the simulation of each candidate after its snapshot.
+     * The current schedules are restored afterwards, and the intersections are not marked as changed,
+     * but the run state is the resumed run of the other schedules.
+     *
+     * @param indices Indices of the intersections in the non-trivial intersections of the city plan
+     * (i.e. the same indices as in `non_trivial_schedules`).
+     * @param orders Orders of streets of the other schedules.
+     * @param times Green light times of the other schedules.
+     * @param relative_order If True, `orders` must contain street indices relative to each intersection.
+     * Otherwise, `orders` must contain street IDs.
+     */
+    Comparison compare(
+        const std::vector<unsigned long> &indices, const std::vector<std::vector<unsigned long>> &orders,
+        const std::vector<std::vector<unsigned long>> &times, bool relative_order = false
+    );
+
+    /**
+     * Return the statistics of the street queues in a run of the current schedules indexed by street IDs.
+     *
+     * The cars still waiting at the end of the run are counted as waiting until the end. The statistics
+     * are only collected on request, so the simulation is run first, unless the last complete run was
+     * a run of the current schedules that already collected them.
+     */
+    std::vector<QueueStats> queue_stats();
+
+    /**
+     * Redistribute the green light times of all non-trivial intersections in proportion to the demand
+     * observed in a run of the current schedules, keeping the order of the streets.
+     *
+     * The demand of a street is the number of cars that waited at its traffic light, see `queue_stats()`.
+     * The cars that passed on green don't need more time, so counting them would favor the streets that
+     * already have enough. Each street reached by a car keeps one second for such cars, the streets no car
+     * reached get no green light, and the remaining seconds of the cycle are split in proportion to the demand
+     * using the largest remainder method (evenly among the reached streets if no car waited). Intersections
+     * that no car reached keep their times, unless a target cycle length is given, which is then split evenly.
+     *
+     * @param cycle Cycle length of the rebalanced schedules (at least one second per street reached by a car),
+     * or nothing to keep the cycle length of each schedule.
+     */
+    void rebalance_times(std::optional<unsigned long> cycle = {});
+
+    /**
+     * Return the IDs of the intersections whose schedules changed since the last call
+     * of `clear_dirty_intersections`, in the order they were first changed.
+     *
+     * Setting a non-trivial schedule to the same order and times doesn't mark it as changed.
+     */
+    const std::vector<unsigned long> &dirty_intersections() const {
+        return dirty_intersections_;
+    }
+
+    /**
+     * Forget the intersections whose schedules changed.
+     */
+    void clear_dirty_intersections();
+
 private:
     /** Custom separator to ensure correct thousand separators in the output. */
     class ThousandSeparator : public std::numpunct<char> {
@@ -148,11 +428,85 @@ private:
         }
     };
 
+    /**
+     * Results of a run kept by `compare` for the schedules it was run with.
+     */
+    struct ComparedRun {
+        /** Hash of the schedules of the run. */
+        std::uint64_t schedules_hash{};
+        /** Score of the run. */
+        unsigned long score{};
+        /** Time each car arrived at its destination, if it has arrived, indexed by car IDs. */
+        std::vector<std::optional<unsigned long>> arrival_times;
+        /** Snapshots of the run ordered by their times, the first one at time zero. */
+        std::vector<Snapshot> snapshots;
+    };
+
+    /**
+     * Run state with 32-bit indices and times, or with 64-bit ones if the city plan doesn't fit in 32 bits.
+     */
+    using RunStateVariant = std::variant<RunState<std::uint32_t>, RunState<std::uint64_t>>;
+
+    /**
+     * Create the narrowest run state that fits the given city plan.
+     *
+     * @param city_plan City plan containing information from the input file.
+     */
+    static RunStateVariant make_run_state(const city_plan::CityPlan &city_plan);
+
     /**
      * Run the simulation.
      */
     void run();
 
+    /**
+     * Run the simulation unless the run state already holds a complete run of the current schedules.
+     */
+    void ensure_run();
+
+    /**
+     * Run the simulation using the given run state.
+     *
+     * @param state Run state of the simulation.
+     */
+    template<std::unsigned_integral Index>
+    void run(RunState<Index> &state);
+
+    /**
+     * Process the events occurring before the given time.
+     *
+     * Events after the end of the simulation are never processed.
+     *
+     * @param state Run state of the simulation.
+     * @param time Time until which to process the events.
+     */
+    template<std::unsigned_integral Index>
+    void run_until(RunState<Index> &state, unsigned long time);
+
+    /**
+     * Return the estimate of the full score of a run paused at the given horizon, see `score(horizon)`.
+     *
+     * @param state Run state of the simulation.
+     * @param horizon Time at which the run was paused.
+     */
+    template<std::unsigned_integral Index>
+    unsigned long estimate_score(const RunState<Index> &state, unsigned long horizon) const;
+
+    /**
+     * Compute the earliest time any car can reach each non-trivial intersection, see `earliest_arrivals_`.
+     */
+    void compute_earliest_arrivals();
+
+    /**
+     * Run the simulation with the current schedules and keep its results and snapshots for `compare()`.
+     */
+    void record_compared_run();
+
+    /**
+     * Return the time each car arrived at its destination in the last run, if it has arrived, indexed by car IDs.
+     */
+    std::vector<std::optional<unsigned long>> arrival_times() const;
+
     /**
      * Reset the simulation run state.
      */
@@ -163,6 +517,32 @@ private:
      */
     void reset_schedules();
 
+    /**
+     * Compute the hash of the current schedules from scratch.
+     */
+    void rehash_schedules();
+
+    /**
+     * Set the schedule of the given intersection and update the hash of the schedules.
+     *
+     * @param schedule Schedule to set.
+     * @param order Order of streets in the schedule (street IDs).
+     * @param times Green light times for each street in the order.
+     */
+    void set_schedule(Schedule &schedule, std::vector<unsigned long> &&order, std::vector<unsigned long> &&times);
+
+    /**
+     * Mark the schedule of the given intersection as changed.
+     *
+     * @param intersection_id ID of the intersection.
+     */
+    void mark_dirty(unsigned long intersection_id);
+
+    /**
+     * Mark the schedules of all intersections with a schedule as changed.
+     */
+    void mark_all_dirty();
+
     /**
      * Assign schedules for all used intersections based on the given order and times initialization options.
      *
@@ -171,6 +551,14 @@ private:
      */
     void assign_schedules(Schedule::Order order_type, Schedule::Times times_type);
 
+    /**
+     * Create schedules for all used intersections, see `create_schedules`.
+     *
+     * @param order_type Order initialization option for the schedules.
+     * @param times_type Times initialization option for the schedules.
+     */
+    void build_schedules(Schedule::Order order_type, Schedule::Times times_type);
+
     /**
      * Finalize the schedules after initial assignment.
      *
@@ -181,46 +569,158 @@ private:
      */
     void finalize_schedules(Schedule::Order order_type, Schedule::Times times_type);
 
+    /**
+     * Compute the next green light time of the given street for a car reaching its end at the given time.
+     *
+     * The green light is also marked as used on the street. Green light times at or after the end
+     * of the simulation are not returned because the events would never be processed.
+     *
+     * @param state Run state of the simulation.
+     * @param street_id ID of the street.
+     * @param current_time Time when the car reaches the end of the street.
+     */
+    template<std::unsigned_integral Index>
+    std::optional<Index> use_green(RunState<Index> &state, unsigned long street_id, unsigned long current_time);
+
+    /**
+     * Add the given car to the queue of its current street and return the time it gets the green light.
+     *
+     * Green light times at or after the end of the simulation are not returned
+     * because the events would never be processed. With the street engine, the time is only returned
+     * for the first car in the queue; the other cars get their green light times when they reach the front.
+     *
+     * @param state Run state of the simulation.
+     * @param car The car reaching the end of its current street.
+     * @param current_time Time when the car reaches the end of the street.
+     * @param sequence Sequence number of the car's event.
+     */
+    template<std::unsigned_integral Index>
+    std::optional<Index> enqueue_car(
+        RunState<Index> &state, Car<Index> &car, unsigned long current_time, Index sequence
+    );
+
     /**
      * Add a `StreetEvent` for the given car to the event queue.
      *
      * Schedules a new event for the car based on the current simulation time.
+     * Events after the end of the simulation are not added because they would never be processed.
      *
+     * @param state Run state of the simulation.
      * @param car The car for which to add the event.
      * @param current_time Current time in the simulation.
      */
-    void add_event(Car &car, unsigned long current_time);
+    template<std::unsigned_integral Index>
+    void add_event(RunState<Index> &state, Car<Index> &car, unsigned long current_time);
 
     /**
      * Initialize the run state of the simulation.
+     *
+     * The initial street queues are taken from the cars grouped by their starting streets,
+     * and the initial events are collected in a buffer and turned into the event queue at once.
+     *
+     * @param state Run state of the simulation.
      */
-    void initialize_run();
+    template<std::unsigned_integral Index>
+    void initialize_run(RunState<Index> &state);
 
     /**
      * Process the next `StreetEvent` in the event queue.
      *
      * This method processes the event at the top of the event queue, updating the state of the simulation
      * and scheduling new events as necessary.
+     *
+     * @param state Run state of the simulation.
+     */
+    template<std::unsigned_integral Index>
+    void process_event(RunState<Index> &state);
+
+    /**
+     * Capture the run state in a snapshot taken at the given time.
+     *
+     * @param state Run state of the simulation.
+     * @param time Time at which the run was paused.
      */
-    void process_event();
+    template<std::unsigned_integral Index>
+    Snapshot capture(const RunState<Index> &state, unsigned long time) const;
+
+    /**
+     * Restore the run state from the snapshot using the current schedules.
+     *
+     * @param state Run state of the simulation.
+     * @param snapshot Snapshot of a simulation of the same city plan.
+     */
+    template<std::unsigned_integral Index>
+    void restore(RunState<Index> &state, const Snapshot &snapshot);
+
+    /** Maximum number of strata of the car samples. */
+    static constexpr auto CAR_SAMPLE_STRATA = 8UL;
+    /** Largest number of snapshots of the run of the current schedules kept by `compare()`. */
+    static constexpr auto COMPARE_SNAPSHOTS = 8UL;
+
+    /**
+     * Return the time at which the simulation ends.
+     *
+     * Events at this time or later are never processed, so all later times are stored as this time.
+     */
+    unsigned long end_time() const {
+        return city_plan_.duration() + 1;
+    }
 
     /** City plan containing all information from the input file. */
     const city_plan::CityPlan &city_plan_;
 
-    /** Streets in the simulation. */
-    std::vector<Street> streets_;
-    /** Cars in the simulation. */
-    std::vector<Car> cars_;
+    /** Event scheduling engine used to run the simulation. */
+    Engine engine_ = Engine::CAR;
+
     /** Schedules for intersections indexed by intersection IDs. */
     std::unordered_map<unsigned long, Schedule> schedules_;
+    /** IDs of the non-trivial intersections, in the order of `non_trivial_intersections()`. */
+    std::vector<unsigned long> non_trivial_ids_;
+    /** IDs of the intersections whose schedules changed, see `dirty_intersections()`. */
+    std::vector<unsigned long> dirty_intersections_;
+    /** Whether the schedule of each intersection changed, indexed by intersection IDs. */
+    std::vector<bool> dirty_;
+    /** Hash of the schedules, see `schedules_hash()`. */
+    std::uint64_t schedules_hash_{};
+    /** Cache of scores indexed by hashes of the schedules. */
+    std::shared_ptr<ScoreCache> score_cache_;
+
+    /** "Dynamic" state of the simulation run. */
+    RunStateVariant run_state_;
 
+    /** Score of the last simulation run. */
+    unsigned long total_score_{};
     /**
-     * Event queue for the simulation, containing `StreetEvent` objects.
+     * Hash of the schedules of the complete run held by the run state, or nothing if the run state was reset,
+     * or holds a partial run, a run of the sampled cars or a resumed run.
      */
-    std::priority_queue<StreetEvent, std::vector<StreetEvent>, std::greater<>> event_queue_;
+    std::optional<std::uint64_t> run_hash_;
 
-    /** Score of the last simulation run. */
-    unsigned long total_score_{};
+    /** Results of the run of the current schedules of the last comparison, see `compare()`. */
+    std::optional<ComparedRun> compared_run_;
+    /**
+     * Earliest time any car can reach each non-trivial intersection, or the end time if no car can,
+     * in the order of `non_trivial_ids_`; computed by the first comparison.
+     */
+    std::vector<unsigned long> earliest_arrivals_;
+
+    /** Writer of the event trace while `trace()` runs the simulation, nullptr otherwise. */
+    TraceWriter *trace_ = nullptr;
+    /** Whether each car is in the sample of `set_car_sample()` indexed by car IDs, or empty if there's none. */
+    std::vector<bool> sampled_cars_;
+    /** Stratum of each car indexed by car IDs, only set with a sample. */
+    std::vector<unsigned long> car_strata_;
+    /** Number of cars of each stratum, only set with a sample. */
+    std::vector<unsigned long> stratum_sizes_;
+    /** Whether the current run only adds the sampled cars to the streets, see `sampled_score()`. */
+    bool sampling_{};
+    /** Whether the current run collects the statistics of the street queues, see `queue_stats()`. */
+    bool collecting_queue_stats_{};
+    /**
+     * Order in which the cars are added to their starting streets at the beginning of a run,
+     * or empty for the order of car IDs; only set for construction runs of `adaptive_variants()`.
+     */
+    std::vector<unsigned long> car_order_;
 };
 
 /**
@@ -240,6 +740,24 @@ Simulation default_simulation(const city_plan::CityPlan &city_plan);
  * @param city_plan City plan containing information from the input file.
  */
 Simulation adaptive_simulation(const city_plan::CityPlan &city_plan);
+
+/**
+ * Check that the schedules can be set by `Simulation::set_non_trivial_schedules`, which doesn't validate them.
+ *
+ * Throws `std::invalid_argument` unless there is one schedule per non-trivial intersection, the order and the times
+ * of every schedule have the same size, and every street in the orders is a valid street ID (or a valid index
+ * of a used street of the intersection with `relative_order`).
+ *
+ * @param city_plan City plan of the simulations the schedules are for.
+ * @param schedules Vector of `(order, times)` pairs, where each pair is a schedule for one intersection.
+ * @param relative_order If True, `order` must be a vector of street indices relative to each intersection.
+ * Otherwise, `order` must be a vector of street IDs.
+ */
+void validate_non_trivial_schedules(
+    const city_plan::CityPlan &city_plan,
+    const std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>> &schedules,
+    bool relative_order = false
+);
 }
 
 #endif
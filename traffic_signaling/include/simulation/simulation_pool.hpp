@@ -0,0 +1,162 @@
+#ifndef SIMULATION_SIMULATION_POOL_HPP
+#define SIMULATION_SIMULATION_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "city_plan/city_plan.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simulation {
+/**
+ * Bounded pool of simulation replicas leased to any thread.
+ *
+ * The pool builds one template replica with the default schedules and creates the other replicas
+ * lazily by copying it, which copies the flat run state instead of creating the schedules again.
+ * A leased replica keeps the schedules set by its previous lessee, so callers should set all
+ * schedules they want to score.
+ */
+class SimulationPool {
+public:
+    /**
+     * Exclusive access to one replica of the pool; the replica is returned when the lease is released or destroyed.
+     */
+    class Lease {
+    public:
+        Lease(Lease &&other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)), simulation_(std::exchange(other.simulation_, nullptr)) {}
+
+        Lease &operator=(Lease &&other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                simulation_ = std::exchange(other.simulation_, nullptr);
+            }
+            return *this;
+        }
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease() {
+            release();
+        }
+
+        /**
+         * Return the leased replica.
+         *
+         * Throws `std::logic_error` if the lease was already released.
+         */
+        Simulation &simulation() const;
+
+        Simulation &operator*() const {
+            return simulation();
+        }
+
+        Simulation *operator->() const {
+            return &simulation();
+        }
+
+        /**
+         * Return True if the lease still holds a replica.
+         */
+        bool active() const {
+            return simulation_ != nullptr;
+        }
+
+        /**
+         * Return the replica to the pool; releasing an inactive lease does nothing.
+         */
+        void release();
+
+    private:
+        friend class SimulationPool;
+
+        Lease(SimulationPool &pool, Simulation &simulation)
+            : pool_(&pool), simulation_(&simulation) {}
+
+        /** Pool owning the replica. */
+        SimulationPool *pool_;
+        /** Leased replica, or nullptr if the lease was released. */
+        Simulation *simulation_;
+    };
+
+    /**
+     * Construct a simulation pool for the given city plan.
+     *
+     * @param city_plan City plan containing information from the input file.
+     * @param max_replicas Maximum number of replicas, by default the number of hardware threads.
+     * @param cache Score cache shared by the replicas, or nullptr to disable caching.
+     */
+    explicit SimulationPool(
+        const city_plan::CityPlan &city_plan, unsigned long max_replicas = default_replicas(),
+        std::shared_ptr<ScoreCache> cache = nullptr
+    );
+
+    SimulationPool(const SimulationPool &) = delete;
+    SimulationPool &operator=(const SimulationPool &) = delete;
+
+    /**
+     * Lease a replica, cloning a new one if all replicas are leased and the limit is not reached yet.
+     *
+     * Blocks until a replica is returned if all `max_replicas` replicas are leased.
+     * The pool must outlive the returned lease.
+     */
+    Lease acquire();
+
+    /**
+     * Return the number of replicas created so far, including the leased ones.
+     */
+    unsigned long replicas() const;
+
+    /**
+     * Return the number of replicas that can be leased without waiting.
+     */
+    unsigned long available() const;
+
+    /**
+     * Return the maximum number of replicas.
+     */
+    unsigned long max_replicas() const {
+        return max_replicas_;
+    }
+
+    /**
+     * Return the number of hardware threads, or 1 if it can't be determined.
+     */
+    static unsigned long default_replicas() {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+private:
+    /**
+     * Return the replica to the idle replicas and wake up one waiting thread.
+     *
+     * @param simulation Replica leased from this pool.
+     */
+    void release(Simulation &simulation);
+
+    /** Replica with the default schedules that the other replicas are cloned from; it's never leased. */
+    const Simulation template_;
+    /** Maximum number of replicas. */
+    unsigned long max_replicas_;
+
+    /** Mutex guarding the replicas. */
+    mutable std::mutex mutex_;
+    /** Condition variable signalling a returned replica. */
+    std::condition_variable released_;
+    /** Replicas created so far; the pointers keep their addresses stable for the leases. */
+    std::vector<std::unique_ptr<Simulation>> replicas_;
+    /** Number of replicas being cloned outside the lock. */
+    unsigned long cloning_{};
+    /** Replicas that are not leased. */
+    std::vector<Simulation *> idle_;
+};
+}
+
+#endif
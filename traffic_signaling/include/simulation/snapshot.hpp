@@ -0,0 +1,43 @@
+#ifndef SIMULATION_SNAPSHOT_HPP
+#define SIMULATION_SNAPSHOT_HPP
+
+#include <optional>
+#include <vector>
+
+#include "simulation/street.hpp"
+
+namespace simulation {
+/**
+ * Snapshot of a simulation run paused at a given time.
+ *
+ * Contains the complete "dynamic" state of the run stored in flat vectors, so that it is cheap to copy
+ * and can be resumed by any simulation of the same city plan (e.g. by replicas on other threads).
+ *
+ * The event queue and the latest used times of the streets are not stored because they are derived
+ * from the street queues when resuming. This is also what allows resuming with different schedules.
+ */
+struct Snapshot {
+    /** Time at which the run was paused; all events occurring before this time have been processed. */
+    unsigned long time{};
+    /** Score accumulated by the cars that arrived at their destination before `time`. */
+    unsigned long score{};
+    /** Sequence number of the next event. */
+    unsigned long sequence{};
+
+    /** Index of the street each car is currently on in its path, indexed by car IDs. */
+    std::vector<unsigned long> path_indices;
+    /** Time each car arrived at its destination, if it has arrived, indexed by car IDs. */
+    std::vector<std::optional<unsigned long>> arrival_times;
+
+    /**
+     * Offsets of the street queues in `queued_cars` indexed by street IDs.
+     *
+     * The queue of street `i` is stored in `queued_cars[queue_offsets[i]:queue_offsets[i + 1]]`.
+     */
+    std::vector<unsigned long> queue_offsets;
+    /** Cars waiting in the street queues, stored one street after another. */
+    std::vector<QueuedCar<unsigned long>> queued_cars;
+};
+}
+
+#endif
@@ -1,17 +1,131 @@
 #ifndef SIMULATION_STREET_HPP
 #define SIMULATION_STREET_HPP
 
+#include <concepts>
 #include <optional>
-#include <queue>
+#include <span>
+#include <vector>
 
 #include "city_plan/street.hpp"
 
 namespace simulation {
+/**
+ * Car waiting in a street's queue for the green light.
+ *
+ * @tparam Index Unsigned integer type used to store the ID, time and sequence number.
+ */
+template<std::unsigned_integral Index>
+struct QueuedCar {
+    /** ID of the car. */
+    Index id;
+    /** Time the car reached the end of the street. */
+    Index arrival_time;
+    /**
+     * Sequence number of the car's event.
+     *
+     * Used to break ties in the event queue when two events occur at the same time.
+     */
+    Index sequence;
+};
+
+/**
+ * FIFO queue of cars waiting at a traffic light.
+ *
+ * The cars are stored in a vector and popped by advancing the index of the front car; the vector is cleared
+ * whenever the queue becomes empty. Unlike `std::deque`, an empty queue owns no memory, so the streets
+ * of a simulation that hasn't run yet are copied without any allocations.
+ *
+ * @tparam Index Unsigned integer type used to store the ID, time and sequence number.
+ */
+template<std::unsigned_integral Index>
+class CarQueue {
+public:
+    using const_iterator = typename std::vector<QueuedCar<Index>>::const_iterator;
+
+    /**
+     * Add a car to the back of the queue.
+     *
+     * @param car Car to add.
+     */
+    void push_back(const QueuedCar<Index> &car) {
+        cars_.push_back(car);
+    }
+
+    /**
+     * Remove the car at the front of the queue.
+     */
+    void pop_front() {
+        if (++front_ == cars_.size()) {
+            clear();
+        }
+    }
+
+    /**
+     * Return the car at the front of the queue.
+     */
+    const QueuedCar<Index> &front() const {
+        return cars_[front_];
+    }
+
+    /**
+     * Remove all cars from the queue, keeping the allocated memory.
+     */
+    void clear() {
+        cars_.clear();
+        front_ = 0;
+    }
+
+    /**
+     * Return the number of cars in the queue.
+     */
+    std::size_t size() const {
+        return cars_.size() - front_;
+    }
+
+    /**
+     * Return True if the queue is empty.
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    const_iterator begin() const {
+        return cars_.begin() + static_cast<std::ptrdiff_t>(front_);
+    }
+
+    const_iterator end() const {
+        return cars_.end();
+    }
+
+private:
+    /** Cars in the queue preceded by the already popped cars. */
+    std::vector<QueuedCar<Index>> cars_;
+    /** Index of the front car in `cars_`. */
+    std::size_t front_{};
+};
+
+/**
+ * Statistics of the queue of a street in a simulation run.
+ */
+struct QueueStats {
+    /** Number of cars that reached the traffic light, including the cars still waiting at the end of the run. */
+    unsigned long cars{};
+    /** Number of cars that waited for the green light, including the cars still waiting at the end of the run. */
+    unsigned long waiting_cars{};
+    /** Total time the cars waited for the green light. */
+    unsigned long waiting_time{};
+    /** Largest number of cars waiting at the same time. */
+    unsigned long max_queue{};
+};
+
 /**
  * Street in the simulation.
  *
  * Contains the "dynamic" data and operates the street during the simulation.
+ *
+ * @tparam Index Unsigned integer type used to store car IDs and times in the street.
  */
+template<std::unsigned_integral Index>
 class Street {
 public:
     /**
@@ -26,22 +140,29 @@ public:
      * Add a car to the street's queue.
      *
      * @param car_id ID of the car.
-     * @param time Time when the car receives the green light and can move to the next street.
+     * @param arrival_time Time when the car reaches the end of the street.
+     * @param sequence Sequence number of the car's event.
      */
-    void add_car(unsigned long car_id, unsigned long time) {
-        car_queue_.emplace(car_id);
-        latest_used_time_ = time;
+    void add_car(Index car_id, Index arrival_time, Index sequence) {
+        car_queue_.push_back({car_id, arrival_time, sequence});
     }
 
     /**
      * Pop the first car from the street's queue and return its ID.
      */
-    unsigned long get_car() {
-        auto &&car = car_queue_.front();
-        car_queue_.pop();
+    Index get_car() {
+        auto car = car_queue_.front().id;
+        car_queue_.pop_front();
         return car;
     }
 
+    /**
+     * Return the cars waiting in the street's queue.
+     */
+    const CarQueue<Index> &queue() const {
+        return car_queue_;
+    }
+
     /**
      * Return the ID of the street.
      */
@@ -52,17 +173,41 @@ public:
     /**
      * Return the latest time a car passed the traffic light on this street.
      */
-    std::optional<unsigned long> latest_used_time() const {
+    std::optional<Index> latest_used_time() const {
         return latest_used_time_;
     }
 
+    /**
+     * Set the latest time a car passed the traffic light on this street.
+     *
+     * @param time Time when the car receives the green light and can move to the next street.
+     */
+    void set_latest_used_time(Index time) {
+        latest_used_time_ = time;
+    }
+
     /**
      * Reset the street to its initial state.
      *
      * This method is used for performance reasons to avoid frequent reallocation.
      */
     void reset() {
-        car_queue_ = {};
+        car_queue_.clear();
+        latest_used_time_ = {};
+    }
+
+    /**
+     * Restore the street's queue from a snapshot.
+     *
+     * @param queue Cars waiting in the street's queue.
+     */
+    void restore(std::span<const QueuedCar<unsigned long>> queue) {
+        car_queue_.clear();
+        for (auto &&car: queue) {
+            add_car(
+                static_cast<Index>(car.id), static_cast<Index>(car.arrival_time), static_cast<Index>(car.sequence)
+            );
+        }
         latest_used_time_ = {};
     }
 
@@ -70,10 +215,10 @@ private:
     /** "Static" information of the street from the city plan. */
     const city_plan::Street &data_;
 
-    /** Queue of cars (represented by their IDs) waiting to pass the traffic light on this street. */
-    std::queue<unsigned long> car_queue_;
+    /** Queue of cars waiting to pass the traffic light on this street. */
+    CarQueue<Index> car_queue_;
     /** The latest time a car passed the traffic light on this street. */
-    std::optional<unsigned long> latest_used_time_;
+    std::optional<Index> latest_used_time_;
 };
 }
 
@@ -0,0 +1,174 @@
+#ifndef SIMULATION_TRACE_HPP
+#define SIMULATION_TRACE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace simulation {
+/** Kinds of records in an event trace. */
+enum class TraceEvent : std::uint8_t {
+    /** The car got the green light and left the street. */
+    PASS = 0,
+    /** The car was still waiting in the street's queue at the end of the simulation. */
+    WAITING = 1,
+};
+
+/**
+ * One car movement recorded in an event trace.
+ *
+ * The car waited in the queue of the street from `arrival_time` until `time`.
+ */
+struct TraceRecord {
+    /** Kind of the record. */
+    TraceEvent event;
+    /** ID of the car. */
+    unsigned long car_id;
+    /** ID of the street the car waited on. */
+    unsigned long street_id;
+    /** Time the car reached the end of the street and joined its queue. */
+    unsigned long arrival_time;
+    /** Time the car got the green light, or the end time of the simulation for `WAITING` records. */
+    unsigned long time;
+};
+
+/** Header of an event trace describing the traced city plan. */
+struct TraceHeader {
+    /** Duration of the simulation in seconds. */
+    unsigned long duration;
+    /** Number of streets in the city plan. */
+    unsigned long streets;
+    /** Number of cars in the city plan. */
+    unsigned long cars;
+};
+
+/**
+ * Writer of compact binary event traces.
+ *
+ * The file starts with the magic bytes `TSTRACE1` followed by the header fields, and then the records
+ * in the order of their times. All numbers are unsigned LEB128 varints. Each record is its event byte,
+ * the car ID, the street ID, the difference of its time and the time of the previous record, and
+ * the waiting time `time - arrival_time`, so most records take only a few bytes.
+ *
+ * The records are buffered and written in large blocks.
+ */
+class TraceWriter {
+public:
+    /**
+     * Create the trace file and write its header.
+     *
+     * @param filename Path of the trace file.
+     * @param header Description of the traced city plan.
+     */
+    TraceWriter(const std::string &filename, const TraceHeader &header);
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    /**
+     * Write the remaining buffered records, ignoring errors; call `close` to detect them.
+     */
+    ~TraceWriter();
+
+    /**
+     * Append a record to the trace.
+     *
+     * The records must be appended in the non-decreasing order of their times.
+     *
+     * @param record Record to append.
+     */
+    void write(const TraceRecord &record) {
+        buffer_.push_back(static_cast<char>(record.event));
+        put(record.car_id);
+        put(record.street_id);
+        put(record.time - previous_time_);
+        put(record.time - record.arrival_time);
+        previous_time_ = record.time;
+        if (buffer_.size() >= FLUSH_SIZE) {
+            flush();
+        }
+    }
+
+    /**
+     * Write the remaining buffered records and close the file.
+     *
+     * Throws `std::runtime_error` if writing the file failed.
+     */
+    void close();
+
+private:
+    /** Size of the buffer at which the records are written to the file. */
+    static constexpr unsigned long FLUSH_SIZE = 1UL << 16;
+
+    /**
+     * Append the value as an unsigned LEB128 varint to the buffer.
+     */
+    void put(std::uint64_t value) {
+        while (value >= 0x80) {
+            buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    /** Write the buffered records to the file. */
+    void flush();
+
+    /** Path of the trace file, used in error messages. */
+    std::string filename_;
+    /** Trace file. */
+    std::ofstream file_;
+    /** Encoded records not written to the file yet. */
+    std::vector<char> buffer_;
+    /** Time of the previous record. */
+    unsigned long previous_time_{};
+};
+
+/**
+ * Reader of binary event traces written by `TraceWriter`.
+ */
+class TraceReader {
+public:
+    /**
+     * Open the trace file and read its header.
+     *
+     * Throws `std::runtime_error` if the file can't be opened or it's not a trace.
+     *
+     * @param filename Path of the trace file.
+     */
+    explicit TraceReader(const std::string &filename);
+
+    /**
+     * Return the header of the trace.
+     */
+    const TraceHeader &header() const {
+        return header_;
+    }
+
+    /**
+     * Read the next record, or return nothing at the end of the trace.
+     *
+     * Throws `std::runtime_error` if the trace is truncated or corrupted.
+     */
+    std::optional<TraceRecord> next();
+
+private:
+    /**
+     * Read an unsigned LEB128 varint.
+     */
+    std::uint64_t get();
+
+    /** Path of the trace file, used in error messages. */
+    std::string filename_;
+    /** Trace file. */
+    std::ifstream file_;
+    /** Header of the trace. */
+    TraceHeader header_{};
+    /** Time of the previous record. */
+    unsigned long previous_time_{};
+};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <functional>
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include "city_plan/city_plan.hpp"
@@ -10,6 +11,34 @@ namespace py = pybind11;
 
 using namespace city_plan;
 
+/**
+ * Return a read-only numpy array viewing the vector without copying it.
+ *
+ * @param values Vector to view; it must not be reallocated while the array exists.
+ * @param owner Python object owning the vector, kept alive by the array.
+ */
+py::array_t<unsigned long> read_only_view(const std::vector<unsigned long> &values, py::handle owner) {
+    py::array_t<unsigned long> array{
+        {values.size()},
+        {sizeof(unsigned long)},
+        values.data(),
+        owner
+    };
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+/**
+ * Return a function binding the vector returned by the given getter as a read-only numpy array.
+ *
+ * @param getter Member function of the city plan returning the vector.
+ */
+auto numpy_view(const std::vector<unsigned long> &(CityPlan::*getter)() const) {
+    return [getter](const py::object &self) {
+        return read_only_view((self.cast<const CityPlan &>().*getter)(), self);
+    };
+}
+
 PYBIND11_MODULE(city_plan, m) {
     m.doc() = "pybind11 city_plan module";
 
@@ -63,7 +92,11 @@ PYBIND11_MODULE(city_plan, m) {
     )
     .def_property_readonly(
         "path",
-        &Car::path,
+        // necessary conversion because pybind doesn't support C++20 ranges/views
+        [](const Car &car) -> std::vector<std::reference_wrapper<const Street>> {
+            auto &&path = car.path();
+            return {path.begin(), path.end()};
+        },
         "Return the path the car has to travel."
     )
     .def(
@@ -111,11 +144,6 @@ PYBIND11_MODULE(city_plan, m) {
         &Street::id,
         "Return the ID of the street."
     )
-    .def_property_readonly(
-        "name",
-        &Street::name,
-        "Return the name of the street."
-    )
     .def_property_readonly(
         "used",
         &Street::used,
@@ -147,13 +175,17 @@ PYBIND11_MODULE(city_plan, m) {
     );
 
     py_CityPlan.def(
-        py::init<const std::string &>(),
+        py::init<const std::string &, unsigned long>(),
         py::arg("filename"),
+        py::arg("threads") = CityPlan::default_threads(),
         py::call_guard<py::gil_scoped_release>(),
         R"doc(
         Create a city plan from the input data file.
 
+        The cars are parsed on multiple threads, but the city plan is the same for any number of threads.
+
         :param filename: Path of the input data file.
+        :param threads: Maximum number of threads parsing the cars, by default the number of hardware threads.
         )doc"
     )
     .def_property_readonly(
@@ -201,9 +233,104 @@ PYBIND11_MODULE(city_plan, m) {
         },
         "Return the non-trivial intersections in this city plan."
     )
+    .def_property_readonly(
+        "street_starts",
+        numpy_view(&CityPlan::street_starts),
+        "Return a read-only array of the starting intersection IDs of the streets indexed by street IDs."
+    )
+    .def_property_readonly(
+        "street_ends",
+        numpy_view(&CityPlan::street_ends),
+        "Return a read-only array of the ending intersection IDs of the streets indexed by street IDs."
+    )
+    .def_property_readonly(
+        "street_lengths",
+        numpy_view(&CityPlan::street_lengths),
+        "Return a read-only array of the lengths of the streets indexed by street IDs."
+    )
+    .def_property_readonly(
+        "street_total_cars",
+        numpy_view(&CityPlan::street_total_cars),
+        "Return a read-only array of the total numbers of cars that use the streets indexed by street IDs."
+    )
+    .def_property_readonly(
+        "path_offsets",
+        numpy_view(&CityPlan::path_offsets),
+        R"doc(
+        Return a read-only array of the offsets of the car paths in `path_street_ids` indexed by car IDs,
+        followed by the total length of all paths.
+
+        The path of the car with ID `i` is `path_street_ids[path_offsets[i]:path_offsets[i + 1]]`.
+        )doc"
+    )
+    .def_property_readonly(
+        "path_street_ids",
+        numpy_view(&CityPlan::path_street_ids),
+        "Return a read-only array of the street IDs in the paths of all cars, one path after another."
+    )
+    .def_property_readonly(
+        "path_remaining_durations",
+        numpy_view(&CityPlan::path_remaining_durations),
+        R"doc(
+        Return a read-only array of the free-flow durations from the end of each street in the paths of all cars
+        to their destinations, in the same order as `path_street_ids`.
+        )doc"
+    )
+    .def_property_readonly(
+        "used_street_offsets",
+        numpy_view(&CityPlan::used_street_offsets),
+        R"doc(
+        Return a read-only array of the offsets of the used streets in `used_street_ids` indexed by intersection IDs,
+        followed by the number of all used streets.
+
+        The used streets of the intersection with ID `i` are `used_street_ids[used_street_offsets[i]:used_street_offsets[i + 1]]`,
+        in the same order as `Intersection.used_streets`.
+        )doc"
+    )
+    .def_property_readonly(
+        "used_street_ids",
+        numpy_view(&CityPlan::used_street_ids),
+        "Return a read-only array of the used street IDs of all intersections, one intersection after another."
+    )
+    .def(
+        "street_id",
+        &CityPlan::street_id,
+        py::arg("name"),
+        R"doc(
+        Return the ID of a street given its name.
+
+        Raises IndexError if there is no street with the name.
+
+        :param name: Name of the street.
+        )doc"
+    )
+    .def(
+        "street_name",
+        &CityPlan::street_name,
+        py::arg("street_id"),
+        R"doc(
+        Return the name of a street given its ID.
+
+        :param street_id: ID of the street.
+        )doc"
+    )
     .def(
         "upper_bound",
         &CityPlan::upper_bound,
         "Return the theoretical maximum score if none of the cars ever has to wait at a traffic light."
+    )
+    .def(
+        "earliest_arrival",
+        &CityPlan::earliest_arrival,
+        py::arg("intersection_id"),
+        R"doc(
+        Return the earliest time any car can reach the traffic light of the given intersection,
+        or None if no car ever waits at it.
+
+        The time assumes that none of the cars has to wait at a traffic light, so it's a lower bound
+        for the time the first car reaches the traffic light with any schedules.
+
+        :param intersection_id: ID of the intersection.
+        )doc"
     );
 }
\ No newline at end of file
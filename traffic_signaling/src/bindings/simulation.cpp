@@ -4,7 +4,11 @@
 #include <pybind11/stl.h>
 
 #include "city_plan/city_plan.hpp"
+#include "simulation/evaluation_pool.hpp"
+#include "simulation/island_model.hpp"
+#include "simulation/score_cache.hpp"
 #include "simulation/simulation.hpp"
+#include "simulation/simulation_pool.hpp"
 
 namespace py = pybind11;
 
@@ -19,6 +23,117 @@ PYBIND11_MODULE(simulation, m) {
         "Schedule of traffic lights for one intersection in the simulation."
     );
 
+    auto py_Snapshot = py::class_<Snapshot>(
+        m,
+        "Snapshot",
+        R"doc(
+        Snapshot of a simulation run paused at a given time.
+
+        The snapshot can be resumed by any simulation of the same city plan, possibly with different schedules.
+        )doc"
+    );
+
+    auto py_CarChange = py::class_<CarChange>(
+        m,
+        "CarChange",
+        "Car whose arrival differs between the runs of two sets of schedules."
+    );
+
+    auto py_Comparison = py::class_<Comparison>(
+        m,
+        "Comparison",
+        "Result of comparing the current schedules of a simulation with other schedules."
+    );
+
+    auto py_QueueStats = py::class_<QueueStats>(
+        m,
+        "QueueStats",
+        "Statistics of the queue of one street in a simulation run."
+    );
+
+    auto py_AdaptiveVariant = py::class_<AdaptiveVariant>(
+        m,
+        "AdaptiveVariant",
+        "Adaptive schedules built by one construction run of `Simulation.adaptive_variants()`."
+    );
+
+    auto py_SampledScore = py::class_<SampledScore>(
+        m,
+        "SampledScore",
+        "Score extrapolated from a run of a sample of the cars, see `Simulation.sampled_score()`."
+    );
+
+    auto py_IslandParameters = py::class_<IslandParameters>(
+        m,
+        "IslandParameters",
+        "Parameters of `island_genetic_algorithm()`; the defaults are the defaults of the genetic algorithm of the optimizer."
+    );
+
+    auto py_IslandGeneration = py::class_<IslandGeneration>(
+        m,
+        "IslandGeneration",
+        "Statistics of one generation of one island of `island_genetic_algorithm()`."
+    );
+
+    auto py_IslandResult = py::class_<IslandResult>(
+        m,
+        "IslandResult",
+        "Result of `island_genetic_algorithm()`."
+    );
+
+    // Held by shared_ptr, because the cache is shared by simulations and evaluation pools
+    auto py_ScoreCache = py::class_<ScoreCache, std::shared_ptr<ScoreCache>>(
+        m,
+        "ScoreCache",
+        R"doc(
+        Bounded cache of scores indexed by hashes of schedules.
+
+        The cache can be shared by several simulations of the same city plan running on different threads.
+        When it is full, the entries are evicted using the CLOCK algorithm (an approximation of LRU).
+        )doc"
+    );
+
+    auto py_ScoreFuture = py::class_<ScoreFuture>(
+        m,
+        "ScoreFuture",
+        "Handle to a score calculated in the background by an EvaluationPool."
+    );
+
+    auto py_EvaluationPool = py::class_<EvaluationPool>(
+        m,
+        "EvaluationPool",
+        R"doc(
+        Pool of worker threads calculating scores of schedules in the background.
+
+        Each worker owns its own replica of the simulation, so the schedules are scored in parallel
+        while Python keeps working (e.g. producing the next schedules to score).
+        The workers can be pinned to CPUs to keep their replicas in the caches and memory of their cores.
+        )doc"
+    );
+
+    auto py_SimulationPool = py::class_<SimulationPool>(
+        m,
+        "SimulationPool",
+        R"doc(
+        Bounded pool of simulation replicas leased to any thread.
+
+        The pool builds one template replica with the default schedules and creates the other replicas
+        lazily by copying it. A leased replica keeps the schedules set by its previous lessee,
+        so callers should set all schedules they want to score.
+        )doc"
+    );
+
+    auto py_SimulationLease = py::class_<SimulationPool::Lease>(
+        m,
+        "SimulationLease",
+        R"doc(
+        Exclusive access to one replica of a SimulationPool.
+
+        The lease is a context manager returning the replica; the replica is returned to the pool
+        when the context is exited, the lease is released, or the lease is garbage collected.
+        )doc"
+    );
+
     auto py_Simulation = py::class_<Simulation>(
         m,
         "Simulation",
@@ -49,6 +164,17 @@ PYBIND11_MODULE(simulation, m) {
         &Schedule::times,
         "Return the green light times for each street in the order."
     )
+    .def_property_readonly(
+        "hash",
+        &Schedule::hash,
+        R"doc(
+        Return the 64-bit hash of the schedule.
+
+        The hash is the XOR of the hashes of the `(position, street ID, time)` slots of the schedule,
+        so the hashes of several schedules can be combined and updated using XOR as well.
+        It is updated whenever the schedule changes. Empty schedules have the hash 0.
+        )doc"
+    )
     .def(
         "relative_order",
         // necessary conversion because pybind doesn't support C++20 ranges/views
@@ -90,6 +216,374 @@ PYBIND11_MODULE(simulation, m) {
         "Default divisor for scaled times schedule option."
     );
 
+    py_Snapshot.def_readonly(
+        "time",
+        &Snapshot::time,
+        "Time at which the run was paused; all events occurring before this time have been processed."
+    )
+    .def_readonly(
+        "score",
+        &Snapshot::score,
+        "Score accumulated by the cars that arrived at their destination before `time`."
+    );
+
+    py_CarChange.def_readonly(
+        "car_id",
+        &CarChange::car_id,
+        "ID of the car."
+    )
+    .def_readonly(
+        "arrival_time",
+        &CarChange::arrival_time,
+        "Time the car arrived at its destination with the current schedules, or None if it hasn't arrived."
+    )
+    .def_readonly(
+        "other_arrival_time",
+        &CarChange::other_arrival_time,
+        "Time the car arrived at its destination with the other schedules, or None if it hasn't arrived."
+    )
+    .def_readonly(
+        "score_delta",
+        &CarChange::score_delta,
+        "Score of the car with the other schedules minus its score with the current schedules."
+    );
+
+    py_Comparison.def_readonly(
+        "score",
+        &Comparison::score,
+        "Score of the current schedules."
+    )
+    .def_readonly(
+        "other_score",
+        &Comparison::other_score,
+        "Score of the other schedules."
+    )
+    .def_readonly(
+        "score_delta",
+        &Comparison::score_delta,
+        "Score of the other schedules minus the score of the current schedules."
+    )
+    .def_readonly(
+        "cars",
+        &Comparison::cars,
+        "Cars whose arrival differs, ordered by car IDs."
+    );
+
+    py_QueueStats.def_readonly(
+        "cars",
+        &QueueStats::cars,
+        "Number of cars that reached the traffic light at the end of the street."
+    )
+    .def_readonly(
+        "waiting_cars",
+        &QueueStats::waiting_cars,
+        "Number of cars that waited in the queue, including the cars still waiting at the end of the run."
+    )
+    .def_readonly(
+        "waiting_time",
+        &QueueStats::waiting_time,
+        "Total time the cars waited in the queue, including the cars still waiting at the end of the run."
+    )
+    .def_readonly(
+        "max_queue",
+        &QueueStats::max_queue,
+        "Maximum number of cars waiting in the queue at the same time."
+    );
+
+    py_AdaptiveVariant.def_readonly(
+        "variant",
+        &AdaptiveVariant::variant,
+        "Index of the variant; variant 0 processes the cars in the order of their IDs."
+    )
+    .def_readonly(
+        "score",
+        &AdaptiveVariant::score,
+        "Score of the schedules."
+    )
+    .def_readonly(
+        "schedules",
+        &AdaptiveVariant::schedules,
+        "Schedules of the non-trivial intersections in the format of `Simulation.non_trivial_schedules()`."
+    );
+
+    py_SampledScore.def_readonly(
+        "estimate",
+        &SampledScore::estimate,
+        "Estimate of the score of all cars."
+    )
+    .def_readonly(
+        "error",
+        &SampledScore::error,
+        R"doc(
+        Standard error of the estimate due to the choice of the cars.
+
+        It doesn't account for the bias caused by the queues being shorter than with all cars.
+        )doc"
+    )
+    .def_readonly(
+        "score",
+        &SampledScore::score,
+        "Score of the sampled cars."
+    )
+    .def_readonly(
+        "cars",
+        &SampledScore::cars,
+        "Number of sampled cars."
+    );
+
+    py_IslandParameters.def(py::init<>())
+    .def_readwrite("islands", &IslandParameters::islands, "Number of islands, each evolved by its own thread.")
+    .def_readwrite("population", &IslandParameters::population, "Number of individuals of each island.")
+    .def_readwrite("generations", &IslandParameters::generations, "Maximum number of generations of each island.")
+    .def_readwrite("crossover", &IslandParameters::crossover, "Probability of mating each pair of individuals.")
+    .def_readwrite("mutation", &IslandParameters::mutation, "Probability of mutating each individual.")
+    .def_readwrite(
+        "mutation_indpb",
+        &IslandParameters::mutation_indpb,
+        "Probability of mutating each street of a mutated individual (its position and its time)."
+    )
+    .def_readwrite(
+        "max_time",
+        &IslandParameters::max_time,
+        "Largest green light time produced by mutations; 0 means the duration of the city plan."
+    )
+    .def_readwrite(
+        "elitism",
+        &IslandParameters::elitism,
+        "Fraction of the best individuals passed to the next generation unchanged."
+    )
+    .def_readwrite("tournsize", &IslandParameters::tournsize, "Number of individuals in each tournament.")
+    .def_readwrite(
+        "migration_interval",
+        &IslandParameters::migration_interval,
+        "Number of generations between two migrations of an island."
+    )
+    .def_readwrite(
+        "migrants",
+        &IslandParameters::migrants,
+        "Number of the best individuals sent to the next island in each migration."
+    )
+    .def_readwrite("seed", &IslandParameters::seed, "Seed of the random engines of the islands.")
+    .def_readwrite(
+        "target",
+        &IslandParameters::target,
+        "Score at which all islands stop, e.g. an upper bound of the score, or None."
+    );
+
+    py_IslandGeneration.def_readonly("island", &IslandGeneration::island, "Index of the island.")
+    .def_readonly(
+        "generation",
+        &IslandGeneration::generation,
+        "Generation number; generation 0 is the initial population."
+    )
+    .def_readonly(
+        "evaluations",
+        &IslandGeneration::evaluations,
+        "Number of individuals evaluated in the generation."
+    )
+    .def_readonly("max_score", &IslandGeneration::max_score, "Highest score in the population.")
+    .def_readonly("average_score", &IslandGeneration::average_score, "Average score of the population.");
+
+    py_IslandResult.def_readonly(
+        "schedules",
+        &IslandResult::schedules,
+        "Schedules of the non-trivial intersections of the best individual, with relative orders."
+    )
+    .def_readonly("score", &IslandResult::score, "Score of the best individual.")
+    .def_readonly(
+        "history",
+        &IslandResult::history,
+        "Statistics of all generations of all islands, ordered by generations and islands."
+    )
+    .def_readonly("migrations", &IslandResult::migrations, "Number of migrants received by the islands.");
+
+    py_ScoreCache.def(
+        py::init<unsigned long>(),
+        py::arg("capacity") = ScoreCache::DEFAULT_CAPACITY,
+        R"doc(
+        Create an empty score cache.
+
+        :param capacity: Maximum number of scores kept in the cache.
+        )doc"
+    )
+    .def(
+        "clear",
+        &ScoreCache::clear,
+        "Remove all entries from the cache and reset the hit and miss counters."
+    )
+    .def_property_readonly(
+        "hits",
+        &ScoreCache::hits,
+        "Return the number of lookups that found a score."
+    )
+    .def_property_readonly(
+        "misses",
+        &ScoreCache::misses,
+        "Return the number of lookups that didn't find a score."
+    )
+    .def_property_readonly(
+        "size",
+        &ScoreCache::size,
+        "Return the number of scores in the cache."
+    )
+    .def_property_readonly(
+        "capacity",
+        &ScoreCache::capacity,
+        "Return the maximum number of scores kept in the cache."
+    );
+
+    py_ScoreFuture.def(
+        "result",
+        &ScoreFuture::result,
+        // Release the GIL while waiting, so that the other Python threads can run
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Wait until the score is calculated and return it.
+
+        If the calculation failed, the exception is raised.
+        )doc"
+    )
+    .def(
+        "done",
+        &ScoreFuture::done,
+        "Return True if the score is already calculated."
+    );
+
+    py_EvaluationPool.def(
+        py::init<const city_plan::CityPlan &, unsigned long, std::shared_ptr<ScoreCache>, bool>(),
+        py::arg("city_plan"),
+        py::arg("threads") = EvaluationPool::default_threads(),
+        py::arg("cache") = nullptr,
+        py::arg("pin_threads") = false,
+        // 1: this pointer (EvaluationPool), 2 - first argument (CityPlan)
+        py::keep_alive<1, 2>(),
+        // The workers create their replicas before the constructor returns
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Create an evaluation pool for the given city plan.
+
+        The workers create their own replicas, so the memory of each replica is local to its worker.
+
+        :param city_plan: City plan containing information from the input file.
+        :param threads: Number of worker threads, by default the number of hardware threads.
+        :param cache: Score cache shared by the replicas of the workers, or None to disable caching.
+        :param pin_threads: If True, pin the workers to the CPUs the process may run on, one worker per CPU.
+        Pinning is supported only on Linux and ignored elsewhere.
+        )doc"
+    )
+    .def(
+        "submit",
+        &EvaluationPool::submit,
+        py::arg("schedules"),
+        py::arg("relative_order") = false,
+        // The schedules are converted before releasing the GIL, so they can be modified right after submitting
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Submit schedules to be scored by one of the workers and return a handle to the score.
+
+        Raises ValueError if the number of schedules doesn't match the number of non-trivial intersections,
+        the order and the times of a schedule have different sizes, or the order contains an invalid street.
+
+        :param schedules: List of `(order, times)` tuples, where each tuple is a schedule for one intersection.
+        :param relative_order: If True, `order` must be a list of street indices relative to each intersection.
+        Otherwise, `order` must be a list of street IDs.
+        )doc"
+    )
+    .def_property_readonly(
+        "threads",
+        &EvaluationPool::threads,
+        "Return the number of worker threads."
+    )
+    .def_property_readonly(
+        "pinned",
+        &EvaluationPool::pinned,
+        "Return True if every worker was pinned to a CPU."
+    )
+    .def_property_readonly(
+        "scored",
+        &EvaluationPool::scored,
+        "Return the number of jobs scored by each worker so far."
+    );
+
+    py_SimulationPool.def(
+        py::init<const city_plan::CityPlan &, unsigned long, std::shared_ptr<ScoreCache>>(),
+        py::arg("city_plan"),
+        py::arg("max_replicas") = SimulationPool::default_replicas(),
+        py::arg("cache") = nullptr,
+        // 1: this pointer (SimulationPool), 2 - first argument (CityPlan)
+        py::keep_alive<1, 2>(),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Create a simulation pool for the given city plan.
+
+        :param city_plan: City plan containing information from the input file.
+        :param max_replicas: Maximum number of replicas, by default the number of hardware threads.
+        :param cache: Score cache shared by the replicas, or None to disable caching.
+        )doc"
+    )
+    .def(
+        "acquire",
+        &SimulationPool::acquire,
+        // 0: return value (SimulationLease), 1 - this pointer (SimulationPool)
+        py::keep_alive<0, 1>(),
+        // Other threads can return their replicas while this one waits
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Lease a replica, cloning a new one if all replicas are leased and the limit is not reached yet.
+
+        Blocks until a replica is returned if all `max_replicas` replicas are leased.
+        )doc"
+    )
+    .def_property_readonly(
+        "replicas",
+        &SimulationPool::replicas,
+        "Return the number of replicas created so far, including the leased ones."
+    )
+    .def_property_readonly(
+        "available",
+        &SimulationPool::available,
+        "Return the number of replicas that can be leased without waiting."
+    )
+    .def_property_readonly(
+        "max_replicas",
+        &SimulationPool::max_replicas,
+        "Return the maximum number of replicas."
+    );
+
+    py_SimulationLease.def_property_readonly(
+        "simulation",
+        &SimulationPool::Lease::simulation,
+        py::return_value_policy::reference_internal,
+        R"doc(
+        Return the leased replica.
+
+        Raises RuntimeError if the lease was already released.
+        )doc"
+    )
+    .def_property_readonly(
+        "active",
+        &SimulationPool::Lease::active,
+        "Return True if the lease still holds a replica."
+    )
+    .def(
+        "release",
+        &SimulationPool::Lease::release,
+        "Return the replica to the pool; releasing an inactive lease does nothing."
+    )
+    .def(
+        "__enter__",
+        &SimulationPool::Lease::simulation,
+        py::return_value_policy::reference_internal,
+        "Return the leased replica."
+    )
+    .def(
+        "__exit__",
+        [](SimulationPool::Lease &lease, const py::args &) {
+            lease.release();
+        },
+        "Return the replica to the pool."
+    );
+
     m.def(
         "set_seed",
         &set_seed,
@@ -146,11 +640,44 @@ PYBIND11_MODULE(simulation, m) {
         R"doc(
         Create schedules for all used intersections and used streets.
 
+        Adaptive order assigns the slots of the schedules to the streets in the order their first cars
+        reach the intersections while running the simulation. With scaled times, each street gets a slot
+        as long as its scaled time instead of one second.
+
         :param order: Initialization option for the order of streets in the schedules.
         :param times: Initialization option for the green light times in the schedules.
         :param divisor: Divisor for the scaled times option.
         )doc"
     )
+    .def(
+        "adaptive_variants",
+        &Simulation::adaptive_variants,
+        py::arg("variants"),
+        py::arg("times") = "default",
+        py::arg("divisor") = Schedule::DEFAULT_DIVISOR,
+        py::arg("seed") = 0,
+        py::arg("threads") = city_plan::CityPlan::default_threads(),
+        py::arg("relative_order") = false,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Create adaptive schedules from several construction runs on multiple threads and keep the best ones.
+
+        Variant 0 is the same as `create_schedules('adaptive', times, divisor)`. The other variants add
+        the cars to their starting streets in random orders, which changes the order in which streets
+        reaching an intersection at the same time get their slots. Each variant is built on its own copy
+        of the simulation, and the random order of each variant only depends on the seed and its index.
+        The schedules of the best variant are set as the current schedules.
+
+        :param variants: Number of variants, at least 1.
+        :param times: Initialization option for the green light times in the schedules.
+        :param divisor: Divisor for the scaled times option.
+        :param seed: Seed of the random car orders.
+        :param threads: Maximum number of threads building the variants, by default the number of hardware threads.
+        :param relative_order: If True, the orders of the returned schedules contain street indices relative
+        to each intersection. Otherwise, they contain street IDs.
+        :return: All variants ordered from the highest score, ties in the order of the variants.
+        )doc"
+    )
     .def(
         "default_schedules",
         &Simulation::default_schedules,
@@ -210,6 +737,106 @@ PYBIND11_MODULE(simulation, m) {
         This method assumes the input is valid and performs no validation.
         )doc"
     )
+    .def(
+        "update_schedules",
+        &Simulation::update_schedules,
+        py::arg("indices"),
+        py::arg("orders"),
+        py::arg("times"),
+        py::arg("relative_order") = false,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Set the schedules of the given non-trivial intersections, leaving the other schedules untouched.
+
+        The memory of the updated schedules is reused, so updating a few intersections is much cheaper
+        than setting all non-trivial schedules. Schedules set to the same order and times are not marked
+        as changed. All schedules are validated before any of them is applied, so the schedules are left
+        untouched if `ValueError` is raised.
+
+        :param indices: Indices of the intersections in the non-trivial intersections of the city plan
+        (i.e. the same indices as in `non_trivial_schedules()`).
+        :param orders: Orders of streets of the updated schedules.
+        :param times: Green light times of the updated schedules.
+        :param relative_order: If True, `orders` must contain street indices relative to each intersection.
+        Otherwise, `orders` must contain street IDs.
+        )doc"
+    )
+    .def(
+        "compare",
+        &Simulation::compare,
+        py::arg("indices"),
+        py::arg("orders"),
+        py::arg("times"),
+        py::arg("relative_order") = false,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Compare the current schedules with schedules that differ in the given non-trivial intersections.
+
+        Returns the score delta and the cars whose arrival changed. The run of the current schedules captures
+        a few snapshots until the latest time the first car can reach a non-trivial intersection. The other
+        schedules don't affect the run before the first car can reach any of the given intersections, so
+        the run of the other schedules is resumed from the latest snapshot before that time. The arrivals
+        and the snapshots of the current schedules are kept from the previous comparison if the schedules
+        didn't change since then, so comparing several candidates with the same schedules runs only
+        the part of the simulation of each candidate after its snapshot.
+        The current schedules are restored afterwards, and the intersections are not marked as changed,
+        but the run state is the resumed run of the other schedules.
+
+        :param indices: Indices of the intersections in the non-trivial intersections of the city plan
+        (i.e. the same indices as in `non_trivial_schedules()`).
+        :param orders: Orders of streets of the other schedules.
+        :param times: Green light times of the other schedules.
+        :param relative_order: If True, `orders` must contain street indices relative to each intersection.
+        Otherwise, `orders` must contain street IDs.
+        )doc"
+    )
+    .def(
+        "queue_stats",
+        &Simulation::queue_stats,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Return the statistics of the street queues in a run of the current schedules as a list indexed
+        by street IDs.
+
+        The cars still waiting at the end of the run are counted as waiting until the end. The statistics
+        are only collected on request, so the simulation is run first, unless the last complete run was
+        a run of the current schedules that already collected them.
+        )doc"
+    )
+    .def(
+        "rebalance_times",
+        &Simulation::rebalance_times,
+        py::arg("cycle") = py::none(),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Redistribute the green light times of all non-trivial intersections in proportion to the number
+        of cars that waited at each traffic light in a run of the current schedules, keeping the order
+        of the streets.
+
+        Each street reached by a car keeps one second for the cars passing on green, the streets no car
+        reached get no green light, and the remaining seconds of the cycle are split in proportion to
+        the waiting cars using the largest remainder method. Intersections that no car reached keep their
+        times, unless a target cycle length is given, which is then split evenly.
+
+        :param cycle: Cycle length of the rebalanced schedules (at least one second per street reached by a car),
+        or None to keep the cycle length of each schedule.
+        )doc"
+    )
+    .def_property_readonly(
+        "dirty_intersections",
+        &Simulation::dirty_intersections,
+        R"doc(
+        Return the IDs of the intersections whose schedules changed since the last call
+        of `clear_dirty_intersections()`, in the order they were first changed.
+
+        Setting a non-trivial schedule to the same order and times doesn't mark it as changed.
+        )doc"
+    )
+    .def(
+        "clear_dirty_intersections",
+        &Simulation::clear_dirty_intersections,
+        "Forget the intersections whose schedules changed."
+    )
     .def(
         "non_trivial_schedules",
         &Simulation::non_trivial_schedules,
@@ -222,9 +849,42 @@ PYBIND11_MODULE(simulation, m) {
         Otherwise, `order` is a list of street IDs.
         )doc"
     )
+    .def_property(
+        "engine",
+        &Simulation::engine,
+        &Simulation::set_engine,
+        R"doc(
+        Event scheduling engine used to run the simulation, either 'car' or 'street'.
+
+        The 'car' engine keeps an event for every car waiting at a traffic light. The 'street' engine keeps
+        at most one event per street, which keeps the event queue small when long queues form.
+        Both engines give the same scores.
+        )doc"
+    )
+    .def_property(
+        "score_cache",
+        &Simulation::score_cache,
+        &Simulation::set_score_cache,
+        R"doc(
+        Cache of scores used by `score()`, or None if there is none.
+
+        The cache can be shared by several simulations of the same city plan, including simulations
+        running on other threads, but it must not be shared with simulations of other city plans.
+        )doc"
+    )
+    .def_property_readonly(
+        "schedules_hash",
+        &Simulation::schedules_hash,
+        R"doc(
+        Return the 64-bit hash of the current schedules.
+
+        The hash is the XOR of the hashes of all schedules, and it is updated incrementally
+        whenever some of the schedules change.
+        )doc"
+    )
     .def(
         "score",
-        &Simulation::score,
+        py::overload_cast<>(&Simulation::score),
         // Release the GIL when running the simulation
         //
         // This is especially important for this method because it
@@ -234,7 +894,134 @@ PYBIND11_MODULE(simulation, m) {
         R"doc(
         Calculate the score for the current setting of schedules.
 
-        This method runs the simulation.
+        This method runs the simulation. If a score cache is set and it already contains the score
+        of the current schedules, the cached score is returned without running the simulation. The run state
+        then still belongs to the previous run, so the methods reporting it run the simulation again.
+        )doc"
+    )
+    .def(
+        "score",
+        py::overload_cast<unsigned long>(&Simulation::score),
+        py::arg("horizon"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Run the simulation only until the given horizon and return an estimate of the full score.
+
+        The estimate is the score of the cars whose last traffic light is passed before the horizon, plus
+        partial credit for the cars still on their way: each of them is expected to reach its destination
+        after the free-flow duration of its remaining streets, waiting at each of its remaining traffic lights
+        as long as the cars waited on average per traffic light before the horizon. The cars expected after
+        the end of the simulation get no credit. The runtime grows with the horizon, and from the duration
+        of the simulation on, the estimate is the exact score.
+
+        Unlike `score()`, the estimate isn't cached, but the exact score is returned if the cache contains it.
+
+        :param horizon: Time until which the simulation is run.
+        )doc"
+    )
+    .def(
+        "set_car_sample",
+        &Simulation::set_car_sample,
+        py::arg("fraction"),
+        py::arg("seed") = 0,
+        R"doc(
+        Select a deterministic stratified sample of the cars for `sampled_score()`.
+
+        The cars are split into strata of equal sizes by the free-flow durations of their paths. Ordered by
+        their strata and then by the intersections they start at, every `1 / fraction`-th car is sampled from
+        a random offset, so every stratum and every part of the city is represented in proportion to its cars.
+        The sample only depends on the fraction and the seed.
+
+        Raises `ValueError` if the fraction is not in (0, 1].
+
+        :param fraction: Fraction of the cars to sample.
+        :param seed: Seed of the random offset.
+        )doc"
+    )
+    .def(
+        "clear_car_sample",
+        &Simulation::clear_car_sample,
+        "Remove the sample of the cars."
+    )
+    .def_property_readonly(
+        "car_sample",
+        &Simulation::car_sample,
+        "Return the IDs of the sampled cars in ascending order, or an empty list if no sample is set."
+    )
+    .def(
+        "sampled_score",
+        &Simulation::sampled_score,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Run the simulation with only the sampled cars and extrapolate the score of all cars.
+
+        The other cars never enter the streets. The estimate scales the score of the sampled cars of each stratum
+        by the size of the stratum. Fewer cars form shorter queues, so the estimate is biased upwards
+        on congested city plans (see `calibrate_car_sample()`); the reported error only covers the choice
+        of the cars. The score cache is bypassed, because the cached scores are the scores of all cars.
+
+        Raises `RuntimeError` if no sample is set, see `set_car_sample()`.
+        )doc"
+    )
+    .def(
+        "trace",
+        &Simulation::trace,
+        py::arg("filename"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Run the simulation while recording every car movement to a binary event trace, and return the score.
+
+        Each time a car gets the green light, a `PASS` record with the car, the street and the times of its arrival
+        at the traffic light and of the green light is written. The cars still waiting at the end of the run are
+        written as `WAITING` records. The score cache is bypassed, so the simulation is always run.
+        The trace can be inspected with the `replay_trace` tool.
+
+        :param filename: Path of the trace file.
+        )doc"
+    )
+    .def(
+        "snapshot",
+        &Simulation::snapshot,
+        py::arg("time"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Run the simulation until the given time and capture its state.
+
+        All events occurring before `time` are processed using the current schedules.
+
+        :param time: Time at which to pause the run.
+        )doc"
+    )
+    .def(
+        "resume",
+        &Simulation::resume,
+        py::arg("snapshot"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Resume the run captured in the snapshot and return the final score.
+
+        The current schedules are applied from the snapshot time onwards. Resuming with the same schedules
+        that were used to create the snapshot gives the same score as `score()`.
+
+        :param snapshot: Snapshot of a simulation of the same city plan.
+        )doc"
+    )
+    .def(
+        "optimize_rotation",
+        &Simulation::optimize_rotation,
+        py::arg("intersection_id"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Find the best cyclic rotation of the schedule of the given intersection and apply it.
+
+        Rotating the order (and the times with it) shifts when each street's green light starts within the cycle.
+        The run is paused when the first car can reach the intersection, and every rotation is evaluated by resuming
+        it, so the part of the run before that time is simulated only once. On ties, the smallest rotation is kept.
+
+        Returns a `(rotation, score)` tuple, where rotation `r` means the schedule starts with the street
+        at index `r` of the original order.
+
+        :param intersection_id: ID of the intersection with a schedule.
         )doc"
     )
     .def(
@@ -243,7 +1030,11 @@ PYBIND11_MODULE(simulation, m) {
         // DO NOT release the GIL when redirecting stdout!
         // https://pybind11.readthedocs.io/en/stable/advanced/pycpp/utilities.html#capturing-standard-output-from-ostream
         py::call_guard<py::scoped_ostream_redirect>(),
-        "Print a summary of the simulation statistics."
+        R"doc(
+        Print a summary of the simulation statistics.
+
+        The simulation is run first, unless the last complete run was a run of the current schedules.
+        )doc"
     )
     .def_property_readonly(
         "schedules",
@@ -282,4 +1073,29 @@ PYBIND11_MODULE(simulation, m) {
         :param city_plan: City plan containing information from the input file.
         )doc"
     );
+
+    m.def(
+        "island_genetic_algorithm",
+        &island_genetic_algorithm,
+        py::arg("city_plan"),
+        py::arg("initial"),
+        py::arg("parameters") = IslandParameters{},
+        py::arg("cache") = nullptr,
+        py::call_guard<py::gil_scoped_release>(),
+        R"doc(
+        Run a genetic algorithm with one population per island, each island evolved by its own thread
+        against its own simulation replica.
+
+        Each generation uses the same operators as `operators.py` of the optimizer. Every `migration_interval`
+        generations, an island sends copies of its best individuals to a lock-free queue of the next island
+        (the islands form a ring), which replaces its worst individuals with them. The islands never wait
+        for each other, so with more than one island the result also depends on the timing of the threads.
+
+        :param city_plan: City plan containing information from the input file.
+        :param initial: Initial individuals in the format of `Simulation.non_trivial_schedules(relative_order=True)`;
+            the islands take them in turns.
+        :param parameters: Parameters of the algorithm.
+        :param cache: Score cache shared by the replicas of the islands, or None to disable caching.
+        )doc"
+    );
 }
\ No newline at end of file
@@ -1,38 +1,116 @@
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <fstream>
 #include <stdexcept>
-#include <set>
 #include <functional>
 #include <numeric>
+#include <span>
+#include <thread>
 
 #include "city_plan/city_plan.hpp"
 
 namespace city_plan {
 
-CityPlan::CityPlan(const std::string &filename) { // NOLINT(*-pro-type-member-init)
-    std::ifstream file{filename};
-    if (!file.is_open()) {
-        throw std::runtime_error{"Could not open file " + filename};
+namespace {
+    /** Minimum size in bytes of a chunk of the car section parsed by one thread. */
+    constexpr unsigned long MIN_CHUNK_SIZE = 1UL << 18;
+
+    bool is_space(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    /**
+     * Return the next whitespace-separated token and remove it from the view,
+     * or an empty token if there are only whitespaces left.
+     */
+    std::string_view next_token(std::string_view &data) {
+        auto begin = std::ranges::find_if_not(data, is_space) - data.begin();
+        auto end = std::find_if(data.begin() + begin, data.end(), is_space) - data.begin();
+        auto token = data.substr(static_cast<unsigned long>(begin), static_cast<unsigned long>(end - begin));
+        data.remove_prefix(static_cast<unsigned long>(end));
+        return token;
+    }
+
+    /**
+     * Return the token parsed as a number.
+     */
+    unsigned long parse_number(std::string_view token) {
+        unsigned long number;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), number);
+        if (token.empty() || error != std::errc{} || end != token.data() + token.size()) {
+            throw std::runtime_error{"Invalid number in input data: " + std::string{token}};
+        }
+        return number;
+    }
+
+    /**
+     * Return the next token parsed as a number and remove it from the view.
+     */
+    unsigned long next_number(std::string_view &data) {
+        return parse_number(next_token(data));
+    }
+
+    /**
+     * Read the whole file into a string.
+     */
+    std::string read_file(const std::string &filename) {
+        std::ifstream file{filename, std::ios::binary | std::ios::ate};
+        if (!file.is_open()) {
+            throw std::runtime_error{"Could not open file " + filename};
+        }
+        std::string data(static_cast<unsigned long>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        return data;
+    }
+
+    /**
+     * Split the data into at most the given number of chunks consisting of whole lines.
+     */
+    std::vector<std::string_view> split_lines(std::string_view data, unsigned long chunks) {
+        std::vector<std::string_view> result;
+        unsigned long begin = 0;
+        for (unsigned long i = 1; i <= chunks && begin < data.size(); ++i) {
+            auto end = data.size();
+            if (i < chunks) {
+                // Move the end of the chunk behind the end of the line it falls into
+                end = std::min(data.find('\n', std::max(begin, data.size() / chunks * i)), data.size() - 1) + 1;
+            }
+            result.push_back(data.substr(begin, end - begin));
+            begin = end;
+        }
+        return result;
     }
-    *this = CityPlan{file};
 }
 
-CityPlan::CityPlan(std::ifstream &file) { // NOLINT(*-pro-type-member-init)
-    unsigned long number_of_intersections;
-    unsigned long number_of_streets;
-    unsigned long number_of_cars;
+CityPlan::CityPlan(const std::string &filename, unsigned long threads) { // NOLINT(*-pro-type-member-init)
+    auto file = read_file(filename);
+    std::string_view data{file};
 
-    file >> duration_ >> number_of_intersections >> number_of_streets
-         >> number_of_cars >> bonus_;
+    duration_ = next_number(data);
+    auto number_of_intersections = next_number(data);
+    auto number_of_streets = next_number(data);
+    auto number_of_cars = next_number(data);
+    bonus_ = next_number(data);
 
     intersections_.reserve(number_of_intersections);
     streets_.reserve(number_of_streets);
-    street_mapping_.reserve(number_of_streets);
+    street_names_.reserve(number_of_streets);
     cars_.reserve(number_of_cars);
+    street_starts_.reserve(number_of_streets);
+    street_ends_.reserve(number_of_streets);
+    street_lengths_.reserve(number_of_streets);
+    path_offsets_.reserve(number_of_cars + 1);
 
     for (unsigned long id = 0; id < number_of_intersections; ++id) {
         intersections_.emplace_back(id);
     }
-    read_streets(file, number_of_streets);
-    read_cars(file, number_of_cars);
+    read_streets(data, number_of_streets);
+    if (threads == 0) {
+        throw std::invalid_argument{"City plan needs at least one thread to read the cars"};
+    }
+    read_cars(data, number_of_cars, threads);
 }
 
 unsigned long CityPlan::upper_bound() const {
@@ -47,50 +125,170 @@ unsigned long CityPlan::upper_bound() const {
     return std::accumulate(score_view.begin(), score_view.end(), 0UL);
 }
 
-void CityPlan::read_streets(std::ifstream &file, unsigned long count) {
-    unsigned long start_id;
-    unsigned long end_id;
-    std::string name;
-    unsigned long length;
+std::optional<unsigned long> CityPlan::earliest_arrival(unsigned long intersection_id) const {
+    std::optional<unsigned long> earliest;
+    for (auto &&car: cars()) {
+        auto &&path = car.path();
+        unsigned long time = 0;
+        // Cars on the last street of their path don't wait at the traffic light
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            const Street &street = path[i];
+            // The car starts at the end of the first street
+            if (i > 0) {
+                time += street.length();
+            }
+            if (earliest.has_value() && time >= *earliest) {
+                break;
+            }
+            if (street.end().id() == intersection_id) {
+                earliest = time;
+                break;
+            }
+        }
+    }
+    return earliest;
+}
+
+void CityPlan::read_streets(std::string_view &data, unsigned long count) {
     for (unsigned long id = 0; id < count; ++id) {
-        file >> start_id >> end_id >> name >> length;
+        auto start_id = next_number(data);
+        auto end_id = next_number(data);
+        auto name = next_token(data);
+        auto length = next_number(data);
+        if (start_id >= intersections_.size() || end_id >= intersections_.size()) {
+            throw std::runtime_error{"Invalid intersection of street " + std::string{name}};
+        }
         auto &&start = intersections_[start_id];
         auto &&end = intersections_[end_id];
-        auto &&street = streets_.emplace_back(id, start, end, std::move(name), length);
-        street_mapping_.emplace(street.name(), id);
+        auto &&street = streets_.emplace_back(id, start, end, length);
+        street_names_.add(name);
         intersections_[end_id].add_street(street);
+        street_starts_.push_back(start_id);
+        street_ends_.push_back(end_id);
+        street_lengths_.push_back(length);
     }
 }
 
-void CityPlan::read_cars(std::ifstream &file, unsigned long count) {
-    unsigned long path_length;
-    std::string street_name;
+void CityPlan::read_cars(std::string_view data, unsigned long count, unsigned long threads) {
+    // Small inputs are parsed faster than the threads are started
+    auto chunks = split_lines(data, std::min(threads, data.size() / MIN_CHUNK_SIZE + 1));
+
+    std::vector<CarChunk> parsed(chunks.size());
+    std::vector<std::exception_ptr> errors(chunks.size());
+    auto parse = [&](unsigned long i) {
+        try {
+            parsed[i] = read_car_chunk(chunks[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned long i = 1; i < chunks.size(); ++i) {
+            workers.emplace_back(parse, i);
+        }
+        if (!chunks.empty()) {
+            parse(0);
+        }
+    }
+    for (auto &&error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    unsigned long cars = 0;
+    unsigned long path_streets = 0;
+    for (auto &&chunk: parsed) {
+        cars += chunk.path_lengths.size();
+        path_streets += chunk.street_ids.size();
+    }
+    if (cars != count) {
+        throw std::runtime_error{
+            "Expected " + std::to_string(count) + " cars in input data, found " + std::to_string(cars)
+        };
+    }
+
+    // Stitch the chunks together in their order and merge the partial counts of cars
+    path_offsets_.push_back(0);
+    path_street_ids_.reserve(path_streets);
+    std::vector<unsigned long> total_cars(streets_.size());
+    for (auto &&chunk: parsed) {
+        for (auto path_length: chunk.path_lengths) {
+            path_offsets_.push_back(path_offsets_.back() + path_length);
+        }
+        path_street_ids_.insert(path_street_ids_.end(), chunk.street_ids.begin(), chunk.street_ids.end());
+        std::ranges::transform(total_cars, chunk.total_cars, total_cars.begin(), std::plus{});
+        chunk = {};
+    }
+
+    // The cars are created only after all paths are read, because their views
+    // would be invalidated by reallocations of the path storage
+    std::span<const unsigned long> street_ids{path_street_ids_};
+    for (unsigned long id = 0; id < count; ++id) {
+        auto path = street_ids.subspan(path_offsets_[id], path_offsets_[id + 1] - path_offsets_[id]);
+        cars_.emplace_back(id, path, streets_.data());
+    }
 
-    std::unordered_map<unsigned long, std::set<unsigned long>> used_streets;
+    // The remaining durations are accumulated from the end of each path
+    path_remaining_durations_.resize(path_street_ids_.size());
     for (unsigned long id = 0; id < count; ++id) {
-        file >> path_length;
+        unsigned long remaining = 0;
+        for (auto i = path_offsets_[id + 1]; i > path_offsets_[id]; --i) {
+            path_remaining_durations_[i - 1] = remaining;
+            remaining += street_lengths_[path_street_ids_[i - 1]];
+        }
+    }
 
-        std::vector<std::reference_wrapper<const Street>> path;
-        path.reserve(path_length);
+    for (auto &&street: streets_) {
+        street.add_cars(total_cars[street.id()]);
+    }
+    street_total_cars_ = std::move(total_cars);
+    index_used_streets();
+}
+
+CityPlan::CarChunk CityPlan::read_car_chunk(std::string_view data) const {
+    CarChunk chunk;
+    chunk.total_cars.resize(streets_.size());
+    for (auto token = next_token(data); !token.empty(); token = next_token(data)) {
+        auto path_length = parse_number(token);
+        if (path_length == 0) {
+            throw std::runtime_error{"Empty path of a car in input data"};
+        }
+        chunk.path_lengths.push_back(path_length);
         for (unsigned long i = 0; i < path_length; ++i) {
-            file >> street_name;
-            auto &&street_id = street_mapping_[street_name];
-            path.emplace_back(streets_[street_id]);
+            auto street_id = street_names_.at(next_token(data));
+            chunk.street_ids.push_back(street_id);
 
             // The last street in path is not used because the car
             // doesn't use the traffic light there
             if (i < path_length - 1) {
-                streets_[street_id].add_car();
-                used_streets[streets_[street_id].end().id()].emplace(street_id);
+                ++chunk.total_cars[street_id];
             }
         }
-        cars_.emplace_back(id, std::move(path));
     }
+    return chunk;
+}
+
+void CityPlan::index_used_streets() {
+    used_street_offsets_.assign(intersections_.size() + 1, 0);
+    for (auto &&street: streets_) {
+        if (street.used()) {
+            ++used_street_offsets_[street.end().id() + 1];
+        }
+    }
+    std::partial_sum(used_street_offsets_.begin(), used_street_offsets_.end(), used_street_offsets_.begin());
 
-    // Make sure to add used streets in the increasing order of intersection ids
-    for (auto &&[intersection_id, street_ids]: used_streets) {
-        for (auto &&street_id: street_ids) {
-            intersections_[intersection_id].add_used_street(streets_[street_id]);
+    // Iterating the streets in the order of their IDs adds the used streets
+    // of every intersection in the increasing order of street IDs
+    used_street_ids_.resize(used_street_offsets_.back());
+    auto positions = used_street_offsets_;
+    for (auto &&street: streets_) {
+        if (street.used()) {
+            auto intersection_id = street.end().id();
+            used_street_ids_[positions[intersection_id]++] = street.id();
+            intersections_[intersection_id].add_used_street(street);
         }
     }
 }
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+
+#include "city_plan/name_table.hpp"
+
+namespace city_plan {
+
+void NameTable::reserve(unsigned long count, unsigned long characters) {
+    arena_.reserve(characters);
+    offsets_.reserve(count + 1);
+    // The index is kept at most half full
+    if (2 * count > index_.size()) {
+        rehash(std::bit_ceil(2 * count));
+    }
+}
+
+unsigned long NameTable::add(std::string_view name) {
+    if (2 * (size() + 1) > index_.size()) {
+        rehash(std::max(16UL, 2 * index_.size()));
+    }
+    auto position = slot(name);
+    if (index_[position] != EMPTY) {
+        throw std::invalid_argument{"Duplicate name " + std::string{name}};
+    }
+    auto id = size();
+    index_[position] = id;
+    arena_.append(name);
+    offsets_.push_back(arena_.size());
+    return id;
+}
+
+std::optional<unsigned long> NameTable::find(std::string_view name) const {
+    if (index_.empty()) {
+        return {};
+    }
+    auto id = index_[slot(name)];
+    if (id == EMPTY) {
+        return {};
+    }
+    return id;
+}
+
+unsigned long NameTable::at(std::string_view name) const {
+    auto id = find(name);
+    if (!id.has_value()) {
+        throw std::out_of_range{"Unknown name " + std::string{name}};
+    }
+    return *id;
+}
+
+unsigned long NameTable::slot(std::string_view name) const {
+    auto mask = index_.size() - 1;
+    auto position = std::hash<std::string_view>{}(name) & mask;
+    // The index is never full, so an empty slot is always found
+    while (index_[position] != EMPTY && this->name(index_[position]) != name) {
+        position = (position + 1) & mask;
+    }
+    return position;
+}
+
+void NameTable::rehash(unsigned long slots) {
+    index_.assign(slots, EMPTY);
+    for (unsigned long id = 0; id < size(); ++id) {
+        index_[slot(name(id))] = id;
+    }
+}
+}
@@ -0,0 +1,221 @@
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "evaluation_daemon/daemon.hpp"
+
+namespace evaluation_daemon {
+
+/** How often the daemon checks whether it should stop while waiting for clients. */
+static constexpr int POLL_TIMEOUT_MS = 100;
+
+Daemon::Daemon(std::string socket_path, unsigned long threads)
+    : socket_path_(std::move(socket_path)), threads_(threads) {
+    if (threads_ == 0) {
+        throw std::invalid_argument{"Daemon needs at least one thread"};
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument{"Socket path is too long"};
+    }
+    std::strncpy(address.sun_path, socket_path_.c_str(), sizeof(address.sun_path) - 1);
+
+    socket_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ < 0) {
+        throw std::system_error{errno, std::generic_category(), "Could not create socket"};
+    }
+    // Replace the socket left behind by a daemon that didn't stop cleanly
+    ::unlink(socket_path_.c_str());
+    if (::bind(socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0
+        || ::listen(socket_, SOMAXCONN) < 0) {
+        auto error = errno;
+        ::close(socket_);
+        throw std::system_error{error, std::generic_category(), "Could not listen on " + socket_path_};
+    }
+}
+
+Daemon::~Daemon() {
+    stop();
+    {
+        // Unblock the clients waiting for requests
+        std::scoped_lock lock{mutex_};
+        for (auto client_socket: client_sockets_) {
+            ::shutdown(client_socket, SHUT_RDWR);
+        }
+    }
+    for (auto &&client: clients_) {
+        client.join();
+    }
+    ::close(socket_);
+    ::unlink(socket_path_.c_str());
+}
+
+void Daemon::serve() {
+    while (!stop_requested_) {
+        pollfd listening{socket_, POLLIN, 0};
+        auto ready = ::poll(&listening, 1, POLL_TIMEOUT_MS);
+        if (ready < 0 && errno != EINTR) {
+            throw std::system_error{errno, std::generic_category(), "Could not wait for clients"};
+        }
+        if (ready <= 0) {
+            continue;
+        }
+
+        auto client_socket = ::accept(socket_, nullptr, nullptr);
+        if (client_socket < 0) {
+            continue;
+        }
+        std::scoped_lock lock{mutex_};
+        // Join the threads of the clients that disconnected, so that they don't pile up
+        std::erase_if(clients_, [this](auto &&client) {
+            return finished_clients_.contains(client.get_id());
+        });
+        finished_clients_.clear();
+        client_sockets_.insert(client_socket);
+        clients_.emplace_back([this, client_socket] {
+            handle(Connection{client_socket});
+        });
+    }
+}
+
+void Daemon::handle(Connection connection) {
+    auto client_socket = connection.socket();
+    try {
+        while (auto request = connection.try_read()) {
+            try {
+                switch (static_cast<Request>(*request)) {
+                case Request::LOAD: {
+                    auto filename = connection.read_string();
+                    auto plan_id = load(filename);
+                    connection.write(static_cast<Word>(Status::OK));
+                    connection.write(plan_id);
+                    break;
+                }
+                case Request::SCORE: {
+                    auto scores = score(connection);
+                    connection.write(static_cast<Word>(Status::OK));
+                    connection.write(scores.size());
+                    for (auto score: scores) {
+                        connection.write(score);
+                    }
+                    break;
+                }
+                default:
+                    // The rest of the message can't be skipped, so the connection can't be used anymore
+                    connection.write(static_cast<Word>(Status::ERROR));
+                    connection.write_string("Unknown request");
+                    connection.flush();
+                    throw ConnectionClosed{};
+                }
+            }
+            catch (const ConnectionClosed &) {
+                throw;
+            }
+            catch (const std::exception &e) {
+                connection.write(static_cast<Word>(Status::ERROR));
+                connection.write_string(e.what());
+            }
+            connection.flush();
+        }
+    }
+    catch (const std::exception &) {
+        // The client disconnected or the daemon is stopping
+    }
+    // Forget the socket before it's closed, so that a new client reusing it isn't shut down by mistake
+    std::scoped_lock lock{mutex_};
+    client_sockets_.erase(client_socket);
+    finished_clients_.insert(std::this_thread::get_id());
+}
+
+Word Daemon::load(const std::string &filename) {
+    {
+        std::scoped_lock lock{mutex_};
+        if (auto it = plan_ids_.find(filename); it != plan_ids_.end()) {
+            return it->second;
+        }
+    }
+
+    // Parsing the file and starting the pool take long, so the other clients aren't blocked meanwhile,
+    // and nothing is registered if either fails
+    LoadedPlan plan;
+    plan.city_plan = std::make_unique<city_plan::CityPlan>(filename);
+    // Schedules submitted again by any of the clients are not simulated twice
+    plan.pool = std::make_unique<simulation::EvaluationPool>(
+        *plan.city_plan, threads_, std::make_shared<simulation::ScoreCache>()
+    );
+
+    std::scoped_lock lock{mutex_};
+    // Another client may have loaded the same file in the meantime, its plan is kept
+    if (auto it = plan_ids_.find(filename); it != plan_ids_.end()) {
+        return it->second;
+    }
+    plans_.push_back(std::move(plan));
+    auto plan_id = static_cast<Word>(plans_.size() - 1);
+    plan_ids_.emplace(filename, plan_id);
+    return plan_id;
+}
+
+std::vector<Word> Daemon::score(Connection &connection) {
+    auto plan_id = connection.read();
+    auto relative_order = connection.read();
+    auto batch_size = connection.read();
+
+    // The whole message is read before validating it, so that the connection can be used after an error
+    std::vector<simulation::EvaluationPool::Schedules> batch;
+    for (Word i = 0; i < batch_size; ++i) {
+        auto &&schedules = batch.emplace_back();
+        auto count = connection.read();
+        for (Word j = 0; j < count; ++j) {
+            auto &&[order, times] = schedules.emplace_back();
+            auto length = connection.read();
+            for (Word k = 0; k < length; ++k) {
+                order.push_back(connection.read());
+            }
+            for (Word k = 0; k < length; ++k) {
+                times.push_back(connection.read());
+            }
+        }
+    }
+
+    LoadedPlan *plan;
+    {
+        std::scoped_lock lock{mutex_};
+        if (plan_id >= plans_.size()) {
+            throw std::invalid_argument{"Unknown plan ID"};
+        }
+        // Plans are never removed, so the pointers stay valid
+        plan = &plans_[plan_id];
+    }
+    if (relative_order > 1) {
+        throw std::invalid_argument{"Relative order must be 0 or 1"};
+    }
+
+    // The whole batch is validated before any of it is submitted, so that no set of an invalid batch is scored
+    for (auto &&schedules: batch) {
+        simulation::validate_non_trivial_schedules(*plan->city_plan, schedules, relative_order != 0);
+    }
+
+    // Submit the whole batch first, so that the sets are scored in parallel
+    std::vector<simulation::ScoreFuture> futures;
+    futures.reserve(batch.size());
+    for (auto &&schedules: batch) {
+        futures.push_back(plan->pool->submit(std::move(schedules), relative_order != 0));
+    }
+    std::vector<Word> scores;
+    scores.reserve(futures.size());
+    for (auto &&future: futures) {
+        scores.push_back(future.result());
+    }
+    return scores;
+}
+}
@@ -0,0 +1,37 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "evaluation_daemon/daemon.hpp"
+
+/** Daemon stopped by the signal handler. */
+static evaluation_daemon::Daemon *running_daemon = nullptr;
+
+extern "C" void handle_signal(int) {
+    if (running_daemon != nullptr) {
+        running_daemon->stop();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    if (args.empty() || args.size() > 2) {
+        std::cerr << "Usage: evaluation_daemon SOCKET_PATH [THREADS]\n";
+        return EXIT_FAILURE;
+    }
+    auto threads = args.size() == 2 ? std::stoul(args[1]) : simulation::EvaluationPool::default_threads();
+
+    evaluation_daemon::Daemon daemon{args[0], threads};
+    running_daemon = &daemon;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+    // Clients closing their connections must not kill the daemon
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "Listening on " << args[0] << " with " << threads << " threads per city plan" << std::endl;
+    daemon.serve();
+    running_daemon = nullptr;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "evaluation_daemon/protocol.hpp"
+
+namespace evaluation_daemon {
+
+// Don't get killed by SIGPIPE when the other side closes the connection
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+Connection Connection::connect(const std::string &socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument{"Socket path is too long"};
+    }
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    Connection connection{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (connection.socket_ < 0) {
+        throw std::system_error{errno, std::generic_category(), "Could not create socket"};
+    }
+    if (::connect(connection.socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        throw std::system_error{errno, std::generic_category(), "Could not connect to " + socket_path};
+    }
+    return connection;
+}
+
+Connection::Connection(Connection &&other) noexcept
+    : socket_(std::exchange(other.socket_, -1)),
+      input_(std::move(other.input_)),
+      input_begin_(other.input_begin_),
+      input_end_(other.input_end_),
+      output_(std::move(other.output_)) {}
+
+Connection &Connection::operator=(Connection &&other) noexcept {
+    if (this != &other) {
+        if (socket_ >= 0) {
+            ::close(socket_);
+        }
+        socket_ = std::exchange(other.socket_, -1);
+        input_ = std::move(other.input_);
+        input_begin_ = other.input_begin_;
+        input_end_ = other.input_end_;
+        output_ = std::move(other.output_);
+    }
+    return *this;
+}
+
+Connection::~Connection() {
+    if (socket_ >= 0) {
+        ::close(socket_);
+    }
+}
+
+bool Connection::fill() {
+    // Move the remaining bytes to the front to make space for the new ones
+    std::memmove(input_.data(), input_.data() + input_begin_, input_end_ - input_begin_);
+    input_end_ -= input_begin_;
+    input_begin_ = 0;
+
+    while (true) {
+        auto received = ::recv(socket_, input_.data() + input_end_, input_.size() - input_end_, 0);
+        if (received > 0) {
+            input_end_ += static_cast<std::size_t>(received);
+            return true;
+        }
+        if (received == 0) {
+            return false;
+        }
+        if (errno != EINTR) {
+            throw std::system_error{errno, std::generic_category(), "Could not receive data"};
+        }
+    }
+}
+
+std::optional<Word> Connection::try_read() {
+    while (input_end_ - input_begin_ < sizeof(Word)) {
+        if (!fill()) {
+            if (input_end_ != input_begin_) {
+                // The connection was closed in the middle of a word
+                throw ConnectionClosed{};
+            }
+            return {};
+        }
+    }
+    Word word;
+    std::memcpy(&word, input_.data() + input_begin_, sizeof(Word));
+    input_begin_ += sizeof(Word);
+    return word;
+}
+
+Word Connection::read() {
+    auto word = try_read();
+    if (!word.has_value()) {
+        throw ConnectionClosed{};
+    }
+    return *word;
+}
+
+std::string Connection::read_string() {
+    auto length = read();
+    std::string string;
+    // The length is not trusted, the string grows only as the words arrive
+    for (Word i = 0; i < length; i += sizeof(Word)) {
+        auto word = read();
+        auto bytes = std::min<Word>(sizeof(Word), length - i);
+        string.append(reinterpret_cast<const char *>(&word), bytes);
+    }
+    return string;
+}
+
+void Connection::write_string(std::string_view string) {
+    write(string.size());
+    for (std::size_t i = 0; i < string.size(); i += sizeof(Word)) {
+        Word word = 0;
+        std::memcpy(&word, string.data() + i, std::min(sizeof(Word), string.size() - i));
+        write(word);
+    }
+}
+
+void Connection::flush() {
+    auto data = reinterpret_cast<const std::byte *>(output_.data());
+    auto size = output_.size() * sizeof(Word);
+    std::size_t sent = 0;
+    while (sent < size) {
+        auto result = ::send(socket_, data + sent, size - sent, SEND_FLAGS);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error{errno, std::generic_category(), "Could not send data"};
+        }
+        sent += static_cast<std::size_t>(result);
+    }
+    output_.clear();
+}
+}
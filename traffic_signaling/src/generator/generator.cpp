@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "generator/generator.hpp"
+
+namespace generator {
+
+namespace {
+    /**
+     * Return a uniformly distributed random number in `[0, n)`.
+     *
+     * `std::uniform_int_distribution` is not used because its results differ between standard libraries,
+     * and the generated city plans must be the same on all platforms.
+     */
+    unsigned long uniform(std::mt19937_64 &random_engine, unsigned long n) {
+        // Reject the lowest values so that the remaining range is divisible by n
+        std::uint64_t threshold = (std::numeric_limits<std::uint64_t>::max() - n + 1) % n;
+        while (true) {
+            auto value = random_engine();
+            if (value >= threshold) {
+                return value % n;
+            }
+        }
+    }
+
+    /**
+     * Return a uniformly distributed random number in `(0, 1]`.
+     */
+    double uniform_real(std::mt19937_64 &random_engine) {
+        // 53 random bits fill the mantissa of a double
+        return static_cast<double>((random_engine() >> 11) + 1) * 0x1.0p-53;
+    }
+
+    /**
+     * Append the name of the intersection (letters in bijective base 26) to the given string.
+     */
+    void append_intersection_name(unsigned long intersection_id, std::string &output) {
+        char letters[16];
+        auto size = 0UL;
+        auto value = intersection_id + 1;
+        while (value > 0) {
+            --value;
+            letters[size++] = static_cast<char>('a' + value % 26);
+            value /= 26;
+        }
+        output.append(std::reverse_iterator{letters + size}, std::reverse_iterator{letters});
+    }
+
+    /**
+     * Append the number followed by the separator to the given string.
+     */
+    void append_number(unsigned long number, char separator, std::string &output) {
+        char digits[24];
+        auto [end, _] = std::to_chars(digits, digits + sizeof(digits), number);
+        output.append(digits, end);
+        output.push_back(separator);
+    }
+
+    std::string to_lower(std::string name) {
+        std::ranges::transform(name, name.begin(), [](auto c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        return name;
+    }
+}
+
+Topology parse_topology(std::string name) {
+    name = to_lower(std::move(name));
+    if (name == "grid") {
+        return Topology::GRID;
+    }
+    else if (name == "hubs") {
+        return Topology::HUBS;
+    }
+    throw std::invalid_argument{"Invalid topology option"};
+}
+
+PathLengths parse_path_lengths(std::string name) {
+    name = to_lower(std::move(name));
+    if (name == "uniform") {
+        return PathLengths::UNIFORM;
+    }
+    else if (name == "geometric") {
+        return PathLengths::GEOMETRIC;
+    }
+    throw std::invalid_argument{"Invalid path lengths option"};
+}
+
+CityPlanGenerator::CityPlanGenerator(const Options &options) : options_(options), random_engine_(options.seed) {
+    validate();
+    streets_.reserve(options_.streets);
+    connections_.reserve(options_.streets);
+
+    // A ring through all intersections gives every intersection an incoming and an outgoing street
+    // and makes every street reachable from any other one
+    for (unsigned long id = 0; id < options_.intersections; ++id) {
+        add_street(id, (id + 1) % options_.intersections);
+    }
+    if (options_.topology == Topology::GRID) {
+        add_grid_streets();
+    }
+    else {
+        add_hub_streets();
+    }
+    add_random_streets();
+    index_outgoing_streets();
+
+    // The set is only needed while building the graph
+    connections_ = {};
+}
+
+void CityPlanGenerator::validate() const {
+    auto intersections = options_.intersections;
+    if (intersections < 2 || intersections > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument{"Number of intersections must be between 2 and 2^32 - 1"};
+    }
+    // Random streets are added by rejection sampling, which gets slow when most connections exist
+    auto max_streets = std::max(intersections, intersections * (intersections - 1) / 2);
+    if (options_.streets < intersections || options_.streets > max_streets) {
+        throw std::invalid_argument{
+            "Number of streets must be between the number of intersections and half of all possible connections"
+        };
+    }
+    if (options_.duration == 0 || options_.cars == 0) {
+        throw std::invalid_argument{"Duration and number of cars must be positive"};
+    }
+    if (options_.max_street_length == 0 || options_.max_street_length > options_.duration) {
+        throw std::invalid_argument{"Maximum street length must be between 1 and the duration"};
+    }
+    if (options_.min_path_length < 2 || options_.min_path_length > options_.max_path_length) {
+        throw std::invalid_argument{"Path lengths must be at least 2 and the minimum must not exceed the maximum"};
+    }
+    if (options_.path_lengths == PathLengths::GEOMETRIC
+        && (options_.mean_path_length < options_.min_path_length
+            || options_.mean_path_length > options_.max_path_length)) {
+        throw std::invalid_argument{"Mean path length must be between the minimum and maximum path lengths"};
+    }
+}
+
+bool CityPlanGenerator::add_street(unsigned long begin, unsigned long end) {
+    if (begin == end || !connections_.insert(begin * options_.intersections + end).second) {
+        return false;
+    }
+    streets_.push_back({begin, end, 1 + uniform(random_engine_, options_.max_street_length)});
+    return true;
+}
+
+void CityPlanGenerator::add_grid_streets() {
+    // The intersections are numbered row by row in a snake-like order,
+    // so that the streets of the ring connect neighbours on the grid
+    auto intersections = options_.intersections;
+    auto rows = std::max(1UL, static_cast<unsigned long>(std::sqrt(static_cast<double>(intersections))));
+    auto columns = (intersections + rows - 1) / rows;
+    auto grid_id = [&](unsigned long row, unsigned long column) {
+        return row * columns + (row % 2 == 0 ? column : columns - 1 - column);
+    };
+
+    std::vector<std::pair<unsigned long, unsigned long>> neighbours;
+    for (unsigned long row = 0; row < rows; ++row) {
+        for (unsigned long column = 0; column < columns; ++column) {
+            auto id = grid_id(row, column);
+            if (id >= intersections) {
+                continue;
+            }
+            auto add_neighbours = [&](unsigned long neighbour_id) {
+                if (neighbour_id < intersections) {
+                    neighbours.emplace_back(id, neighbour_id);
+                    neighbours.emplace_back(neighbour_id, id);
+                }
+            };
+            if (column + 1 < columns) {
+                add_neighbours(grid_id(row, column + 1));
+            }
+            if (row + 1 < rows) {
+                add_neighbours(grid_id(row + 1, column));
+            }
+        }
+    }
+
+    // Fisher-Yates shuffle, so that a random subset of the grid is used when there are not enough streets
+    for (auto i = neighbours.size(); i > 1; --i) {
+        std::swap(neighbours[i - 1], neighbours[uniform(random_engine_, i)]);
+    }
+    for (auto &&[begin, end]: neighbours) {
+        if (streets_.size() == options_.streets) {
+            break;
+        }
+        add_street(begin, end);
+    }
+}
+
+void CityPlanGenerator::add_hub_streets() {
+    auto intersections = options_.intersections;
+    auto hubs = std::max(1UL, intersections / 100);
+
+    // Three quarters of the remaining streets lead to or from the hubs, but at most half of the connections
+    // of the hubs are used to keep the rejection sampling fast
+    auto hub_streets = std::min((options_.streets - streets_.size()) * 3 / 4, hubs * (intersections - 1));
+    auto target = streets_.size() + hub_streets;
+    while (streets_.size() < target) {
+        // The hubs are spread over the ring using a fixed stride
+        auto hub = uniform(random_engine_, hubs) * (intersections / hubs);
+        auto other = uniform(random_engine_, intersections);
+        if (uniform(random_engine_, 2) == 0) {
+            add_street(hub, other);
+        }
+        else {
+            add_street(other, hub);
+        }
+    }
+}
+
+void CityPlanGenerator::add_random_streets() {
+    while (streets_.size() < options_.streets) {
+        add_street(uniform(random_engine_, options_.intersections), uniform(random_engine_, options_.intersections));
+    }
+}
+
+void CityPlanGenerator::index_outgoing_streets() {
+    outgoing_offsets_.assign(options_.intersections + 1, 0);
+    for (auto &&street: streets_) {
+        ++outgoing_offsets_[street.begin + 1];
+    }
+    std::partial_sum(outgoing_offsets_.begin(), outgoing_offsets_.end(), outgoing_offsets_.begin());
+    outgoing_streets_.resize(streets_.size());
+    auto positions = outgoing_offsets_;
+    for (unsigned long id = 0; id < streets_.size(); ++id) {
+        outgoing_streets_[positions[streets_[id].begin]++] = id;
+    }
+}
+
+unsigned long CityPlanGenerator::path_length(std::mt19937_64 &random_engine) const {
+    auto min = options_.min_path_length;
+    auto max = options_.max_path_length;
+    if (options_.path_lengths == PathLengths::UNIFORM) {
+        return min + uniform(random_engine, max - min + 1);
+    }
+    if (options_.mean_path_length == min) {
+        return min;
+    }
+    // Inverse transform sampling of the geometric distribution, the lengths above the maximum are drawn again
+    auto log_failure = std::log1p(-1.0 / static_cast<double>(options_.mean_path_length - min + 1));
+    while (true) {
+        auto length = std::floor(std::log(uniform_real(random_engine)) / log_failure);
+        if (length <= static_cast<double>(max - min)) {
+            return min + static_cast<unsigned long>(length);
+        }
+    }
+}
+
+void CityPlanGenerator::generate_path(
+    std::mt19937_64 &random_engine, std::vector<bool> &used, std::vector<unsigned long> &path
+) const {
+    auto target = path_length(random_engine);
+    // Random walk that never uses a street twice; if it gets stuck, it's started again
+    // from another street a few times, and the longest walk is kept
+    std::vector<unsigned long> walk;
+    path.clear();
+    for (int attempt = 0; attempt < 8 && path.size() < target; ++attempt) {
+        walk.assign(1, uniform(random_engine, streets_.size()));
+        used[walk.back()] = true;
+        while (walk.size() < target) {
+            auto intersection_id = streets_[walk.back()].end;
+            auto first = outgoing_streets_.begin() + static_cast<std::ptrdiff_t>(outgoing_offsets_[intersection_id]);
+            auto last = outgoing_streets_.begin() + static_cast<std::ptrdiff_t>(outgoing_offsets_[intersection_id + 1]);
+            auto unused = std::count_if(first, last, [&](unsigned long street_id) { return !used[street_id]; });
+            if (unused == 0) {
+                break;
+            }
+            // Choose uniformly among the unused outgoing streets
+            auto choice = uniform(random_engine, static_cast<unsigned long>(unused));
+            auto next = *std::find_if(first, last, [&](unsigned long street_id) {
+                return !used[street_id] && choice-- == 0;
+            });
+            used[next] = true;
+            walk.push_back(next);
+        }
+        for (auto street_id: walk) {
+            used[street_id] = false;
+        }
+        if (walk.size() > path.size()) {
+            std::swap(walk, path);
+        }
+    }
+}
+
+void CityPlanGenerator::append_street_name(unsigned long street_id, std::string &output) const {
+    // There is at most one street between two intersections in the same direction, so the names are unique
+    append_intersection_name(streets_[street_id].begin, output);
+    output.push_back('-');
+    append_intersection_name(streets_[street_id].end, output);
+}
+
+void CityPlanGenerator::write(std::ostream &output) const {
+    std::string line;
+    append_number(options_.duration, ' ', line);
+    append_number(options_.intersections, ' ', line);
+    append_number(streets_.size(), ' ', line);
+    append_number(options_.cars, ' ', line);
+    append_number(options_.bonus, '\n', line);
+    output.write(line.data(), static_cast<std::streamsize>(line.size()));
+
+    for (unsigned long id = 0; id < streets_.size(); ++id) {
+        line.clear();
+        append_number(streets_[id].begin, ' ', line);
+        append_number(streets_[id].end, ' ', line);
+        append_street_name(id, line);
+        line.push_back(' ');
+        append_number(streets_[id].length, '\n', line);
+        output.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+
+    // The cars use their own random engine, so that writing the city plan again gives the same cars
+    std::mt19937_64 random_engine{options_.seed + 1};
+    std::vector<bool> used(streets_.size());
+    std::vector<unsigned long> path;
+    for (unsigned long car = 0; car < options_.cars; ++car) {
+        generate_path(random_engine, used, path);
+        line.clear();
+        append_number(path.size(), ' ', line);
+        for (auto street_id: path) {
+            append_street_name(street_id, line);
+            line.push_back(' ');
+        }
+        line.back() = '\n';
+        output.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+    output.flush();
+}
+}
@@ -0,0 +1,66 @@
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "generator/generator.hpp"
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    generator::Options options;
+
+    auto number = [](unsigned long &option) {
+        return [&option](const std::string &value) { option = std::stoul(value); };
+    };
+    std::map<std::string, std::function<void(const std::string &)>> parsers{
+        {"--duration", number(options.duration)},
+        {"--intersections", number(options.intersections)},
+        {"--streets", number(options.streets)},
+        {"--cars", number(options.cars)},
+        {"--bonus", number(options.bonus)},
+        {"--max_street_length", number(options.max_street_length)},
+        {"--min_path_length", number(options.min_path_length)},
+        {"--max_path_length", number(options.max_path_length)},
+        {"--mean_path_length", number(options.mean_path_length)},
+        {"--path_lengths", [&](const std::string &value) { options.path_lengths = generator::parse_path_lengths(value); }},
+        {"--topology", [&](const std::string &value) { options.topology = generator::parse_topology(value); }},
+        {"--seed", number(options.seed)},
+    };
+
+    if (args.empty() || args.size() % 2 == 0) {
+        std::cerr << "Usage: generate_city_plan OUTPUT [--OPTION VALUE]...\n\nOptions:\n";
+        for (auto &&[name, _]: parsers) {
+            std::cerr << "  " << name << "\n";
+        }
+        std::cerr << "\nOUTPUT can be '-' to write to the standard output.\n";
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 1; i < args.size(); i += 2) {
+        if (!parsers.contains(args[i])) {
+            std::cerr << "Unknown option " << args[i] << "\n";
+            return EXIT_FAILURE;
+        }
+        parsers.at(args[i])(args[i + 1]);
+    }
+
+    generator::CityPlanGenerator generator{options};
+    if (args[0] == "-") {
+        generator.write(std::cout);
+        return EXIT_SUCCESS;
+    }
+
+    // A large buffer, because the output can have several gigabytes
+    std::vector<char> buffer(1 << 20);
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(args[0]);
+    if (!file.is_open()) {
+        std::cerr << "Could not open file " << args[0] << "\n";
+        return EXIT_FAILURE;
+    }
+    generator.write(file);
+    return EXIT_SUCCESS;
+}
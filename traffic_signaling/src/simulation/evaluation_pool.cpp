@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "simulation/evaluation_pool.hpp"
+
+namespace simulation {
+
+namespace {
+    /**
+     * Pin the calling thread to one of the CPUs the process may run on and return True on success.
+     *
+     * @param index Index of the CPU among the allowed CPUs, taken modulo their number.
+     */
+    bool pin_to_cpu(unsigned long index) {
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            return false;
+        }
+        auto count = static_cast<unsigned long>(CPU_COUNT(&allowed));
+        if (count == 0) {
+            return false;
+        }
+        index %= count;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed) && index-- == 0) {
+                cpu_set_t pinned;
+                CPU_ZERO(&pinned);
+                CPU_SET(cpu, &pinned);
+                return pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned) == 0;
+            }
+        }
+        return false;
+#else
+        static_cast<void>(index);
+        return false;
+#endif
+    }
+}
+
+EvaluationPool::EvaluationPool(
+    const city_plan::CityPlan &city_plan, unsigned long threads, std::shared_ptr<ScoreCache> cache, bool pin_threads
+) : city_plan_(city_plan),
+    template_([&] {
+        auto simulation = default_simulation(city_plan);
+        simulation.set_score_cache(std::move(cache));
+        return simulation;
+    }()),
+    states_(threads),
+    ready_(static_cast<std::ptrdiff_t>(threads)) {
+    if (threads == 0) {
+        throw std::invalid_argument{"Evaluation pool needs at least one thread"};
+    }
+    workers_.reserve(threads);
+    for (unsigned long i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i, pin_threads](std::stop_token stop_token) {
+            work(stop_token, i, pin_threads);
+        });
+    }
+    ready_.wait();
+
+    // The workers are stopped and joined by their destructors if any of them failed
+    for (auto &&state: states_) {
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+    }
+    pinned_ = pin_threads && std::ranges::all_of(states_, &WorkerState::pinned);
+}
+
+EvaluationPool::~EvaluationPool() {
+    for (auto &&worker: workers_) {
+        worker.request_stop();
+    }
+    for (auto &&worker: workers_) {
+        worker.join();
+    }
+}
+
+ScoreFuture EvaluationPool::submit(Schedules &&schedules, bool relative_order) {
+    // The replicas don't validate the schedules, invalid ones would be read out of bounds by a worker
+    validate_non_trivial_schedules(city_plan_, schedules, relative_order);
+    std::promise<unsigned long> promise;
+    ScoreFuture future{promise.get_future().share()};
+    {
+        std::scoped_lock lock{mutex_};
+        jobs_.push_back({std::move(schedules), relative_order, std::move(promise)});
+    }
+    jobs_available_.notify_one();
+    return future;
+}
+
+std::vector<unsigned long> EvaluationPool::scored() const {
+    std::vector<unsigned long> result;
+    result.reserve(states_.size());
+    for (auto &&state: states_) {
+        result.push_back(state.scored.load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+void EvaluationPool::work(std::stop_token stop_token, unsigned long index, bool pin_thread) {
+    auto &&state = states_[index];
+    try {
+        if (pin_thread) {
+            state.pinned = pin_to_cpu(index);
+        }
+        // Cloning on the worker thread allocates the replica on the memory local to the worker
+        state.simulation.emplace(template_);
+    }
+    catch (...) {
+        state.error = std::current_exception();
+    }
+    auto failed = static_cast<bool>(state.error);
+    ready_.count_down();
+    if (!failed) {
+        score_jobs(stop_token, state);
+    }
+}
+
+void EvaluationPool::score_jobs(std::stop_token stop_token, WorkerState &state) {
+    auto &&simulation = *state.simulation;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock{mutex_};
+            // Returns False only if the stop was requested and there are no jobs left
+            if (!jobs_available_.wait(lock, stop_token, [this] { return !jobs_.empty(); })) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        unsigned long score = 0;
+        std::exception_ptr error;
+        try {
+            simulation.set_non_trivial_schedules(std::move(job.schedules), job.relative_order);
+            score = simulation.score();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        // Counted before the promise is fulfilled, so the count includes every job whose result is available
+        state.scored.fetch_add(1, std::memory_order_relaxed);
+        if (error) {
+            job.promise.set_exception(error);
+        }
+        else {
+            job.promise.set_value(score);
+        }
+    }
+}
+}
@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include "simulation/island_model.hpp"
+#include "simulation/migration_queue.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simulation {
+
+namespace {
+    using Schedules = std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>>;
+    using Schedule = std::pair<std::vector<unsigned long>, std::vector<unsigned long>>;
+
+    /** Individual of an island with its score, if it's evaluated. */
+    struct Member {
+        /** Schedules of the non-trivial intersections with relative orders. */
+        Schedules schedules;
+        /** Score of the schedules, or nothing if they changed since the last evaluation. */
+        std::optional<unsigned long> score;
+    };
+
+    /** Random engine of one island with the helpers of Python's `random` module used by `operators.py`. */
+    class Random {
+    public:
+        Random(unsigned long seed, unsigned long island) : engine_([&] {
+            std::seed_seq seed_sequence{seed, island};
+            return std::mt19937_64{seed_sequence};
+        }()) {}
+
+        /** Return a random number in [0, 1). */
+        double random() {
+            return std::uniform_real_distribution<double>{}(engine_);
+        }
+
+        /** Return a random integer in [low, high]. */
+        unsigned long randint(unsigned long low, unsigned long high) {
+            return std::uniform_int_distribution<unsigned long>{low, high}(engine_);
+        }
+
+    private:
+        std::mt19937_64 engine_;
+    };
+
+    /** Two-point crossover of the times of two schedules, see `_cxTwoPoint` in `operators.py`. */
+    void cx_two_point(Schedule &schedule1, Schedule &schedule2, Random &random) {
+        auto &&times1 = schedule1.second;
+        auto &&times2 = schedule2.second;
+        auto size = std::min(times1.size(), times2.size());
+        auto cxpoint1 = random.randint(1, size);
+        auto cxpoint2 = random.randint(1, size - 1);
+        if (cxpoint2 >= cxpoint1) {
+            ++cxpoint2;
+        }
+        else {
+            std::swap(cxpoint1, cxpoint2);
+        }
+        std::swap_ranges(times1.begin() + cxpoint1, times1.begin() + cxpoint2, times2.begin() + cxpoint1);
+    }
+
+    /** Ordered crossover of the orders (and the times with them) of two schedules, see `_cxOrdered`. */
+    void cx_ordered(Schedule &schedule1, Schedule &schedule2, Random &random) {
+        auto &&[order1, times1] = schedule1;
+        auto &&[order2, times2] = schedule2;
+        auto size = std::min(order1.size(), order2.size());
+
+        auto a = random.randint(0, size - 1);
+        auto b = random.randint(0, size - 2);
+        if (b >= a) {
+            ++b;
+        }
+        if (a > b) {
+            std::swap(a, b);
+        }
+
+        std::vector<bool> holes1(size, true), holes2(size, true);
+        for (size_t i = 0; i < size; ++i) {
+            if (i < a || i > b) {
+                holes1[order2[i]] = false;
+                holes2[order1[i]] = false;
+            }
+        }
+
+        // The values are moved backwards in place, so no value is overwritten before it's read
+        auto k1 = b + 1;
+        auto k2 = b + 1;
+        for (size_t i = 0; i < size; ++i) {
+            auto j = (i + b + 1) % size;
+            if (!holes1[order1[j]]) {
+                order1[k1 % size] = order1[j];
+                times1[k1 % size] = times1[j];
+                ++k1;
+            }
+            if (!holes2[order2[j]]) {
+                order2[k2 % size] = order2[j];
+                times2[k2 % size] = times2[j];
+                ++k2;
+            }
+        }
+
+        for (auto i = a; i <= b; ++i) {
+            std::swap(order1[i], order2[i]);
+            std::swap(times1[i], times2[i]);
+        }
+    }
+
+    /** Shuffle the positions of the streets of the schedule, see `_mutShuffleIndexes`. */
+    void mut_shuffle_indexes(Schedule &schedule, double indpb, Random &random) {
+        auto &&[order, times] = schedule;
+        auto size = order.size();
+        for (size_t i = 0; i < size; ++i) {
+            if (random.random() < indpb) {
+                auto swap_index = random.randint(0, size - 2);
+                if (swap_index >= i) {
+                    ++swap_index;
+                }
+                std::swap(order[i], order[swap_index]);
+                std::swap(times[i], times[swap_index]);
+            }
+        }
+    }
+
+    /** Change the times of the schedule by one second, see `mutation_change_by_one`. */
+    void mut_change_by_one(Schedule &schedule, double indpb, unsigned long low, unsigned long up, Random &random) {
+        for (auto &&time: schedule.second) {
+            if (random.random() < indpb) {
+                if (random.random() < 0.5) {
+                    if (time < up) {
+                        ++time;
+                    }
+                }
+                else if (time > low) {
+                    --time;
+                }
+            }
+        }
+    }
+
+    /** Crossover of the orders, the times or both of each schedule, see `crossover`. */
+    void crossover(Schedules &individual1, Schedules &individual2, Random &random) {
+        for (size_t i = 0; i < individual1.size(); ++i) {
+            auto choice = random.randint(1, 3);
+            if (choice & 0b01) {
+                cx_ordered(individual1[i], individual2[i], random);
+            }
+            if (choice & 0b10) {
+                cx_two_point(individual1[i], individual2[i], random);
+            }
+        }
+    }
+
+    /** Mutation of the orders, the times or both of each schedule, see `mutation`. */
+    void mutation(Schedules &individual, double indpb, unsigned long low, unsigned long up, Random &random) {
+        for (auto &&schedule: individual) {
+            auto choice = random.randint(1, 3);
+            if (choice & 0b01) {
+                mut_shuffle_indexes(schedule, indpb, random);
+            }
+            if (choice & 0b10) {
+                mut_change_by_one(schedule, indpb, low, up, random);
+            }
+        }
+    }
+
+    /** Tournament selection keeping the best individuals, see `tournament_selection_with_elitism`. */
+    std::vector<Member> select(
+        const std::vector<Member> &population, unsigned long tournsize, double elitism, Random &random
+    ) {
+        auto k = population.size();
+        auto num_best = static_cast<size_t>(elitism * static_cast<double>(k));
+        std::vector<const Member *> sorted;
+        for (auto &&member: population) {
+            sorted.push_back(&member);
+        }
+        std::ranges::stable_sort(sorted, std::greater<>{}, [](auto member) {
+            return *member->score;
+        });
+
+        std::vector<Member> selected;
+        selected.reserve(k);
+        for (size_t i = 0; i < num_best; ++i) {
+            selected.push_back(*sorted[i]);
+        }
+        for (auto i = num_best; i < k; ++i) {
+            const Member *winner = nullptr;
+            for (unsigned long j = 0; j < tournsize; ++j) {
+                auto &&aspirant = population[random.randint(0, k - 1)];
+                if (winner == nullptr || *aspirant.score > *winner->score) {
+                    winner = &aspirant;
+                }
+            }
+            selected.push_back(*winner);
+        }
+        return selected;
+    }
+
+    /** State shared by the islands. */
+    struct Archipelago {
+        const city_plan::CityPlan &city_plan;
+        const std::vector<Schedules> &initial;
+        const IslandParameters &parameters;
+        std::shared_ptr<ScoreCache> cache;
+        /** Queue of the migrants received by each island, indexed by islands. */
+        std::vector<std::unique_ptr<MigrationQueue<Member>>> queues;
+        /** Set when an island reaches the target score or fails. */
+        std::atomic<bool> stop{false};
+        /** Number of received migrants. */
+        std::atomic<unsigned long> migrations{0};
+    };
+
+    /** Result of one island. */
+    struct IslandOutcome {
+        Member best;
+        std::vector<IslandGeneration> history;
+        std::exception_ptr error;
+    };
+
+    /** Evolve the population of one island until the last generation or until all islands stop. */
+    void evolve(Archipelago &archipelago, unsigned long island, IslandOutcome &outcome) {
+        auto &&parameters = archipelago.parameters;
+        auto max_time = parameters.max_time == 0 ? archipelago.city_plan.duration() : parameters.max_time;
+        Random random{parameters.seed, island};
+
+        // The replica is created by the thread of the island, so its memory is first touched by that thread
+        auto simulation = default_simulation(archipelago.city_plan);
+        simulation.set_score_cache(archipelago.cache);
+        auto evaluate = [&](std::vector<Member> &population) {
+            unsigned long evaluations = 0;
+            for (auto &&member: population) {
+                if (!member.score.has_value()) {
+                    simulation.set_non_trivial_schedules(Schedules{member.schedules}, true);
+                    member.score = simulation.score();
+                    ++evaluations;
+                }
+            }
+            return evaluations;
+        };
+        auto record = [&](unsigned long generation, unsigned long evaluations, const std::vector<Member> &population) {
+            auto &&best = *std::ranges::max_element(population, {}, [](auto &&member) {
+                return *member.score;
+            });
+            double total = 0;
+            for (auto &&member: population) {
+                total += static_cast<double>(*member.score);
+            }
+            outcome.history.push_back({
+                island, generation, evaluations, *best.score, total / static_cast<double>(population.size())
+            });
+            if (!outcome.best.score.has_value() || *best.score > *outcome.best.score) {
+                outcome.best = best;
+            }
+            if (parameters.target.has_value() && *best.score >= *parameters.target) {
+                archipelago.stop = true;
+            }
+        };
+
+        std::vector<Member> population;
+        population.reserve(parameters.population);
+        for (unsigned long i = 0; i < parameters.population; ++i) {
+            auto &&schedules = archipelago.initial[(island * parameters.population + i) % archipelago.initial.size()];
+            population.push_back({schedules, {}});
+        }
+        record(0, evaluate(population), population);
+
+        auto &&inbound = *archipelago.queues[island];
+        auto &&outbound = *archipelago.queues[(island + 1) % archipelago.queues.size()];
+        for (unsigned long generation = 1; generation <= parameters.generations; ++generation) {
+            if (archipelago.stop) {
+                break;
+            }
+
+            // Migrants replace the worst individuals if they are better
+            while (auto migrant = inbound.pop()) {
+                auto &&worst = *std::ranges::min_element(population, {}, [](auto &&member) {
+                    return *member.score;
+                });
+                if (*migrant->score > *worst.score) {
+                    worst = std::move(*migrant);
+                    ++archipelago.migrations;
+                }
+            }
+
+            auto offspring = select(population, parameters.tournsize, parameters.elitism, random);
+            for (size_t i = 1; i < offspring.size(); i += 2) {
+                if (random.random() < parameters.crossover) {
+                    crossover(offspring[i - 1].schedules, offspring[i].schedules, random);
+                    offspring[i - 1].score.reset();
+                    offspring[i].score.reset();
+                }
+            }
+            for (auto &&member: offspring) {
+                if (random.random() < parameters.mutation) {
+                    mutation(member.schedules, parameters.mutation_indpb, 0, max_time, random);
+                    member.score.reset();
+                }
+            }
+            auto evaluations = evaluate(offspring);
+            population = std::move(offspring);
+            record(generation, evaluations, population);
+
+            if (archipelago.queues.size() > 1 && parameters.migration_interval > 0
+                && generation % parameters.migration_interval == 0) {
+                std::vector<const Member *> sorted;
+                for (auto &&member: population) {
+                    sorted.push_back(&member);
+                }
+                auto count = std::min<size_t>(parameters.migrants, sorted.size());
+                std::ranges::partial_sort(sorted, sorted.begin() + static_cast<long>(count), std::greater<>{}, [](auto member) {
+                    return *member->score;
+                });
+                // Migrants that don't fit into the full queue of the next island are dropped
+                for (size_t i = 0; i < count; ++i) {
+                    outbound.push(Member{*sorted[i]});
+                }
+            }
+        }
+    }
+}
+
+IslandResult island_genetic_algorithm(
+    const city_plan::CityPlan &city_plan, const std::vector<Schedules> &initial,
+    const IslandParameters &parameters, std::shared_ptr<ScoreCache> cache
+) {
+    if (parameters.islands == 0 || parameters.population == 0 || parameters.tournsize == 0) {
+        throw std::invalid_argument{"Islands, population and tournament size must be positive"};
+    }
+    if (initial.empty()) {
+        throw std::invalid_argument{"At least one initial individual is needed"};
+    }
+    // The offspring of valid individuals are valid, so only the initial ones are checked
+    for (auto &&schedules: initial) {
+        validate_non_trivial_schedules(city_plan, schedules, true);
+    }
+
+    Archipelago archipelago{city_plan, initial, parameters, std::move(cache), {}};
+    for (unsigned long i = 0; i < parameters.islands; ++i) {
+        // Room for the migrants of a few migrations in case the island is slower than the previous one
+        archipelago.queues.push_back(std::make_unique<MigrationQueue<Member>>(std::max(1UL, 4 * parameters.migrants)));
+    }
+
+    std::vector<IslandOutcome> outcomes(parameters.islands);
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned long i = 0; i < parameters.islands; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    evolve(archipelago, i, outcomes[i]);
+                }
+                catch (...) {
+                    outcomes[i].error = std::current_exception();
+                    archipelago.stop = true;
+                }
+            });
+        }
+    }
+
+    IslandResult result;
+    for (auto &&outcome: outcomes) {
+        if (outcome.error) {
+            std::rethrow_exception(outcome.error);
+        }
+        if (*outcome.best.score > result.score || result.schedules.empty()) {
+            result.schedules = std::move(outcome.best.schedules);
+            result.score = *outcome.best.score;
+        }
+        result.history.insert(result.history.end(), outcome.history.begin(), outcome.history.end());
+    }
+    std::ranges::sort(result.history, {}, [](auto &&generation) {
+        return std::pair{generation.generation, generation.island};
+    });
+    result.migrations = archipelago.migrations;
+    return result;
+}
+}
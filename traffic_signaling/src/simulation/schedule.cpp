@@ -9,6 +9,14 @@ namespace simulation {
 
 namespace {
     std::mt19937_64 random_engine{42};
+
+    /** Finalizer of the SplitMix64 generator, used to mix the values of schedule slots. */
+    std::uint64_t mix(std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
 }
 
 unsigned long Schedule::divisor_ = DEFAULT_DIVISOR;
@@ -55,45 +63,111 @@ void Schedule::fill_missing_streets() {
             add_street_adaptive(street.id(), 0);
         }
     }
+
+    // Merge the slots of the same street into one green light; with one-second slots
+    // and no unused seconds, the order and times stay the same
+    std::vector<unsigned long> order, times;
+    order.reserve(green_lights_.size());
+    times.reserve(green_lights_.size());
+    auto leading_unused = 0UL;
+    for (auto street_id: order_) {
+        if (order.empty() && street_id == UNUSED) {
+            ++leading_unused;
+        }
+        else if (!order.empty() && (street_id == UNUSED || street_id == order.back())) {
+            ++times.back();
+        }
+        else {
+            order.push_back(street_id);
+            times.push_back(1);
+        }
+    }
+    if (!times.empty()) {
+        times.front() += leading_unused;
+    }
+    set(std::move(order), std::move(times));
 }
 
 void Schedule::add_street_adaptive(unsigned long street_id, unsigned long time) {
     time %= total_duration_;
+    auto width = initial_time(street_id, adaptive_times_);
+    // number of unused slots starting at the given slot, up to the width of the street
+    auto unused_length = [&](unsigned long t) {
+        auto end = t;
+        while (end < total_duration_ && end - t < width && order_[end] == UNUSED) {
+            ++end;
+        }
+        return end - t;
+    };
+
+    std::optional<unsigned long> first_unused;
     for (auto i = 0UL; i < total_duration_; ++i) {
-        // find the first unused slot
+        // find the first unused slots wide enough for the street
         auto t = (time + i) % total_duration_;
-        if (order_[t] == UNUSED) {
-            order_[t] = street_id;
-            green_lights_.try_emplace(street_id, t, t + 1);
+        if (order_[t] != UNUSED) {
+            continue;
+        }
+        if (unused_length(t) == width) {
+            use_slots(street_id, t, t + width);
             return;
         }
+        if (!first_unused.has_value()) {
+            first_unused = t;
+        }
+    }
+    if (!first_unused.has_value()) {
+        throw std::runtime_error{"No unused slot found"};
     }
-    throw std::runtime_error{"No unused slot found"};
+    // no gap is wide enough, so the street gets a shorter green light
+    use_slots(street_id, *first_unused, *first_unused + unused_length(*first_unused));
+}
+
+void Schedule::use_slots(unsigned long street_id, unsigned long begin, unsigned long end) {
+    for (auto t = begin; t < end; ++t) {
+        hash_ ^= slot_hash(t, UNUSED, times_[t]) ^ slot_hash(t, street_id, times_[t]);
+        order_[t] = street_id;
+    }
+    green_lights_.try_emplace(street_id, begin, end);
 }
 
 void Schedule::set(std::vector<unsigned long> &&order, std::vector<unsigned long> &&times, bool relative_order) {
     assert(order.size() == times.size());
     reset();
+    order_ = std::move(order);
+    times_ = std::move(times);
+    index_green_lights(relative_order);
+}
+
+void Schedule::assign(
+    std::span<const unsigned long> order, std::span<const unsigned long> times, bool relative_order
+) {
+    assert(order.size() == times.size());
+    reset();
+    order_.assign(order.begin(), order.end());
+    times_.assign(times.begin(), times.end());
+    index_green_lights(relative_order);
+}
+
+void Schedule::index_green_lights(bool relative_order) {
     if (relative_order) {
         auto street_index_to_street_id = [&](unsigned long &street_index) {
             const city_plan::Street &street = intersection_.used_streets()[street_index];
             street_index = street.id();
         };
         // convert relative order street indices to street ids
-        std::ranges::for_each(order, street_index_to_street_id);
+        std::ranges::for_each(order_, street_index_to_street_id);
     }
-    for (size_t i = 0; i < order.size(); ++i) {
-        green_lights_.try_emplace(order[i], total_duration_, total_duration_ + times[i]);
-        total_duration_ += times[i];
+    for (size_t i = 0; i < order_.size(); ++i) {
+        green_lights_.try_emplace(order_[i], total_duration_, total_duration_ + times_[i]);
+        total_duration_ += times_[i];
+        hash_ ^= slot_hash(i, order_[i], times_[i]);
     }
-    order_ = std::move(order);
-    times_ = std::move(times);
 }
 
 void Schedule::set(Order order_type, Times times_type) {
     // adaptive schedules must be handled separately
     if (order_type == Order::ADAPTIVE) {
-        set_adaptive();
+        set_adaptive(times_type);
         return;
     }
 
@@ -107,39 +181,52 @@ void Schedule::set(Order order_type, Times times_type) {
         deterministic_shuffle(order.begin(), order.end(), random_engine);
     }
 
-    if (times_type == Times::DEFAULT) {
-        times.assign(order.size(), 1UL);
-    }
-    else if (times_type == Times::SCALED) {
-        auto &&car_counts = order | std::views::transform([&](unsigned long street_id) {
-            return intersection_.used_streets()[intersection_.street_index(street_id)].get().total_cars();
-        });
-        auto scale = [](unsigned long car_count) {
-            return std::max(car_count / divisor_, 1UL);
-        };
-        auto &&scaled_car_counts = car_counts | std::views::transform(scale);
-        times.assign(scaled_car_counts.begin(), scaled_car_counts.end());
-    }
+    auto &&initial_times = order | std::views::transform([&](unsigned long street_id) {
+        return initial_time(street_id, times_type);
+    });
+    times.assign(initial_times.begin(), initial_times.end());
 
     set(std::move(order), std::move(times));
 }
 
-void Schedule::set_adaptive() {
+void Schedule::set_adaptive(Times times_type) {
     reset();
     adaptive_ = true;
-    total_duration_ = static_cast<unsigned long>(intersection_.used_streets().size());
+    adaptive_times_ = times_type;
+    for (const city_plan::Street &street: intersection_.used_streets()) {
+        total_duration_ += initial_time(street.id(), times_type);
+    }
     // initialize order with UNUSED since the order is determined adaptively
     order_.resize(total_duration_, UNUSED);
-    // initialize times with 1 second for every street
+    // every second of the cycle is a slot of 1 second until the slots are merged
     times_.resize(total_duration_, 1);
-    green_lights_.reserve(total_duration_);
+    green_lights_.reserve(intersection_.used_streets().size());
+    for (auto i = 0UL; i < total_duration_; ++i) {
+        hash_ ^= slot_hash(i, UNUSED, 1);
+    }
+}
+
+unsigned long Schedule::initial_time(unsigned long street_id, Times times_type) const {
+    if (times_type == Times::SCALED) {
+        const city_plan::Street &street = intersection_.used_streets()[intersection_.street_index(street_id)];
+        return std::max(street.total_cars() / divisor_, 1UL);
+    }
+    return 1;
+}
+
+std::uint64_t Schedule::slot_hash(unsigned long position, unsigned long street_id, unsigned long time) const {
+    // The intersection ID is mixed in so that the hashes of different schedules can be combined
+    return mix(mix(mix(mix(intersection_.id()) ^ position) ^ street_id) ^ time);
 }
 
 void Schedule::reset() {
     adaptive_ = {};
+    adaptive_times_ = {};
     total_duration_ = {};
-    order_ = {};
-    times_ = {};
-    green_lights_ = {};
+    hash_ = {};
+    // Clearing keeps the allocated memory for the next schedule
+    order_.clear();
+    times_.clear();
+    green_lights_.clear();
 }
 }
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "simulation/score_cache.hpp"
+
+namespace simulation {
+
+ScoreCache::ScoreCache(unsigned long capacity)
+    : capacity_(capacity), shards_(std::min(capacity, MAX_SHARDS)) {
+    if (capacity == 0) {
+        throw std::invalid_argument{"Score cache capacity cannot be zero"};
+    }
+    // The capacity is split as evenly as possible
+    for (unsigned long i = 0; i < shards_.size(); ++i) {
+        auto &&shard = shards_[i];
+        shard.capacity = capacity / shards_.size() + (i < capacity % shards_.size() ? 1 : 0);
+        shard.entries.reserve(shard.capacity);
+        shard.positions.reserve(shard.capacity);
+    }
+}
+
+std::optional<unsigned long> ScoreCache::find(std::uint64_t key) {
+    auto &&shard = this->shard(key);
+    {
+        std::scoped_lock lock{shard.mutex};
+        if (auto position = shard.positions.find(key); position != shard.positions.end()) {
+            auto &&entry = shard.entries[position->second];
+            entry.referenced = true;
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return entry.score;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+void ScoreCache::insert(std::uint64_t key, unsigned long score) {
+    auto &&shard = this->shard(key);
+    std::scoped_lock lock{shard.mutex};
+
+    // Another simulation may have scored the same schedules in the meantime
+    if (auto position = shard.positions.find(key); position != shard.positions.end()) {
+        shard.entries[position->second] = {key, score, true};
+        return;
+    }
+    if (shard.entries.size() < shard.capacity) {
+        shard.positions.emplace(key, shard.entries.size());
+        shard.entries.push_back({key, score, false});
+        return;
+    }
+
+    // Advance the clock hand to the first entry not used since it was last passed
+    while (shard.entries[shard.hand].referenced) {
+        shard.entries[shard.hand].referenced = false;
+        shard.hand = (shard.hand + 1) % shard.entries.size();
+    }
+    auto &&victim = shard.entries[shard.hand];
+    shard.positions.erase(victim.key);
+    shard.positions.emplace(key, shard.hand);
+    victim = {key, score, false};
+    shard.hand = (shard.hand + 1) % shard.entries.size();
+}
+
+void ScoreCache::clear() {
+    for (auto &&shard: shards_) {
+        std::scoped_lock lock{shard.mutex};
+        shard.entries.clear();
+        shard.positions.clear();
+        shard.hand = 0;
+    }
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+}
+
+unsigned long ScoreCache::size() const {
+    unsigned long size = 0;
+    for (auto &&shard: shards_) {
+        std::scoped_lock lock{shard.mutex};
+        size += shard.entries.size();
+    }
+    return size;
+}
+}
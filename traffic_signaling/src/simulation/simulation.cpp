@@ -1,43 +1,89 @@
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <numeric>
 #include <optional>
+#include <random>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <variant>
 
 #include "simulation/simulation.hpp"
 
 namespace simulation {
 
-Simulation::Simulation(const city_plan::CityPlan &city_plan) : city_plan_(city_plan) {
-    streets_.reserve(city_plan_.streets().size());
-    cars_.reserve(city_plan_.cars().size());
+namespace {
+    /** Return the string converted to lower case. */
+    std::string to_lower(std::string value) {
+        std::ranges::transform(value, value.begin(), [](auto c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        return value;
+    }
+
+    /** Return the order initialization option of its case-insensitive name. */
+    Schedule::Order parse_order(const std::string &order) {
+        auto name = to_lower(order);
+        if (name == "default") {
+            return Schedule::Order::DEFAULT;
+        }
+        if (name == "adaptive") {
+            return Schedule::Order::ADAPTIVE;
+        }
+        if (name == "random") {
+            return Schedule::Order::RANDOM;
+        }
+        throw std::invalid_argument{"Invalid order option"};
+    }
 
-    for (auto &&s: city_plan_.streets()) {
-        streets_.emplace_back(s);
+    /** Return the times initialization option of its case-insensitive name. */
+    Schedule::Times parse_times(const std::string &times) {
+        auto name = to_lower(times);
+        if (name == "default") {
+            return Schedule::Times::DEFAULT;
+        }
+        if (name == "scaled") {
+            return Schedule::Times::SCALED;
+        }
+        throw std::invalid_argument{"Invalid times option"};
     }
-    for (auto &&c: city_plan_.cars()) {
-        cars_.emplace_back(c);
+}
+
+Simulation::Simulation(const city_plan::CityPlan &city_plan)
+    : city_plan_(city_plan), dirty_(city_plan.intersections().size()), run_state_(make_run_state(city_plan)) {
+    auto &&ids = city_plan.non_trivial_intersections() | std::views::transform(&city_plan::Intersection::id);
+    non_trivial_ids_.assign(ids.begin(), ids.end());
+}
+
+Simulation::RunStateVariant Simulation::make_run_state(const city_plan::CityPlan &city_plan) {
+    if (RunState<std::uint32_t>::fits(city_plan)) {
+        return RunStateVariant{std::in_place_type<RunState<std::uint32_t>>, city_plan};
     }
+    // Fall back to 64 bits for city plans that are too large
+    return RunStateVariant{std::in_place_type<RunState<std::uint64_t>>, city_plan};
 }
 
 void Simulation::reset_run() {
     total_score_ = {};
-    event_queue_ = {};
-    for (auto &&s: streets_) {
-        s.reset();
-    }
-    for (auto &&c: cars_) {
-        c.reset();
-    }
+    run_hash_.reset();
+    std::visit([](auto &state) { state.reset(); }, run_state_);
 }
 
 void Simulation::reset_schedules() {
     for (auto &&s: schedules_) {
         s.second.reset();
     }
+    schedules_hash_ = {};
+    mark_all_dirty();
     // Also reset information from possible previous runs
     reset_run();
 }
@@ -72,6 +118,45 @@ void Simulation::load_schedules(const std::string &filename) {
             intersection_id, city_plan_.intersections()[intersection_id], std::move(order), std::move(times)
         );
     }
+    rehash_schedules();
+    mark_all_dirty();
+}
+
+void Simulation::rehash_schedules() {
+    schedules_hash_ = {};
+    for (auto &&[id, schedule]: schedules_) {
+        schedules_hash_ ^= schedule.hash();
+    }
+}
+
+void Simulation::set_schedule(
+    Schedule &schedule, std::vector<unsigned long> &&order, std::vector<unsigned long> &&times
+) {
+    // The hash of the old schedule is removed and the hash of the new one is added
+    schedules_hash_ ^= schedule.hash();
+    schedule.set(std::move(order), std::move(times));
+    schedules_hash_ ^= schedule.hash();
+    mark_dirty(schedule.intersection_id());
+}
+
+void Simulation::mark_dirty(unsigned long intersection_id) {
+    if (!dirty_[intersection_id]) {
+        dirty_[intersection_id] = true;
+        dirty_intersections_.push_back(intersection_id);
+    }
+}
+
+void Simulation::mark_all_dirty() {
+    for (auto &&[id, schedule]: schedules_) {
+        mark_dirty(id);
+    }
+}
+
+void Simulation::clear_dirty_intersections() {
+    for (auto id: dirty_intersections_) {
+        dirty_[id] = false;
+    }
+    dirty_intersections_.clear();
 }
 
 void Simulation::save_schedules(const std::string &filename) const {
@@ -87,7 +172,7 @@ void Simulation::save_schedules(const std::string &filename) const {
             auto &&times = schedule.times();
             file << times.size() << "\n";
             for (size_t i = 0; i < times.size(); ++i) {
-                file << city_plan_.streets()[street_ids[i]].name() << " "
+                file << city_plan_.street_name(street_ids[i]) << " "
                      << times[i] << "\n";
             }
         }
@@ -116,62 +201,133 @@ void Simulation::finalize_schedules(Schedule::Order order_type, Schedule::Times)
 }
 
 void Simulation::create_schedules(std::string order, std::string times, unsigned long divisor) {
-    auto to_lower = [](auto c) {
-        return static_cast<char>(std::tolower(c));
-    };
+    auto order_type = parse_order(order);
+    auto times_type = parse_times(times);
+    Schedule::set_divisor(divisor);
+    build_schedules(order_type, times_type);
+}
 
-    std::ranges::transform(order, order.begin(), to_lower);
-    std::ranges::transform(times, times.begin(), to_lower);
+void Simulation::build_schedules(Schedule::Order order_type, Schedule::Times times_type) {
+    assign_schedules(order_type, times_type);
+    finalize_schedules(order_type, times_type);
+    rehash_schedules();
+    mark_all_dirty();
+}
 
-    Schedule::Order order_type;
-    Schedule::Times times_type;
-    if (order == "default") {
-        order_type = Schedule::Order::DEFAULT;
-    }
-    else if (order == "adaptive") {
-        order_type = Schedule::Order::ADAPTIVE;
+std::vector<AdaptiveVariant> Simulation::adaptive_variants(
+    unsigned long variants, const std::string &times, unsigned long divisor, unsigned long seed,
+    unsigned long threads, bool relative_order
+) {
+    if (variants == 0) {
+        throw std::invalid_argument{"Number of variants must be positive"};
     }
-    else if (order == "random") {
-        order_type = Schedule::Order::RANDOM;
+    auto times_type = parse_times(times);
+    Schedule::set_divisor(divisor);
+
+    // The first variant is built by this simulation, and the replicas are copied from it
+    // so that they share the schedules of the trivial intersections
+    std::vector<AdaptiveVariant> results(variants);
+    build_schedules(Schedule::Order::ADAPTIVE, times_type);
+    results[0] = {0, score(), non_trivial_schedules(relative_order)};
+
+    std::atomic<unsigned long> next_variant{1};
+    auto build_variants = [&] {
+        Simulation replica{*this};
+        for (auto i = next_variant++; i < variants; i = next_variant++) {
+            // Each variant has its own random engine, so it doesn't depend on the number of threads
+            std::seed_seq seed_sequence{seed, i};
+            std::mt19937_64 random_engine{seed_sequence};
+            replica.car_order_.resize(city_plan_.cars().size());
+            std::iota(replica.car_order_.begin(), replica.car_order_.end(), 0UL);
+            deterministic_shuffle(replica.car_order_.begin(), replica.car_order_.end(), random_engine);
+
+            replica.build_schedules(Schedule::Order::ADAPTIVE, times_type);
+            replica.car_order_.clear();
+            results[i] = {i, replica.score(), replica.non_trivial_schedules(relative_order)};
+        }
+    };
+    auto workers_count = std::max(1UL, std::min(threads, variants - 1));
+    std::vector<std::exception_ptr> errors(workers_count);
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned long i = 0; i < workers_count; ++i) {
+            workers.emplace_back([&, i] {
+                try {
+                    build_variants();
+                }
+                catch (...) {
+                    // The other workers keep building their variants, the error is rethrown after they finish
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
     }
-    else {
-        throw std::invalid_argument{"Invalid order option"};
+    for (auto &&error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
 
-    if (times == "default") {
-        times_type = Schedule::Times::DEFAULT;
-    }
-    else if (times == "scaled") {
-        times_type = Schedule::Times::SCALED;
+    std::ranges::stable_sort(results, std::greater<>{}, &AdaptiveVariant::score);
+    if (results.front().variant != 0) {
+        auto schedules = results.front().schedules;
+        set_non_trivial_schedules(std::move(schedules), relative_order);
     }
-    else {
-        throw std::invalid_argument{"Invalid times option"};
+    return results;
+}
+
+template<std::unsigned_integral Index>
+void Simulation::initialize_run(RunState<Index> &state) {
+    std::vector<StreetEvent<Index>> events;
+    events.reserve(state.cars.size());
+    if (collecting_queue_stats_) {
+        state.queue_stats.assign(state.streets.size(), {});
     }
 
-    if (order == "adaptive" && times != "default") {
-        throw std::invalid_argument{"'adaptive' order can only be used with 'default' times"};
+    // Ranks of the cars in the processing order, only used if it's not the order of car IDs
+    std::vector<Index> ranks(car_order_.size());
+    for (size_t i = 0; i < car_order_.size(); ++i) {
+        ranks[car_order_[i]] = static_cast<Index>(i);
     }
 
-    Schedule::set_divisor(divisor);
-    assign_schedules(order_type, times_type);
-    finalize_schedules(order_type, times_type);
-}
+    for (size_t i = 0; i < state.cars.size(); ++i) {
+        auto &&car = state.cars[car_order_.empty() ? i : car_order_[i]];
+        if (sampling_ && !sampled_cars_[car.id()]) {
+            continue;
+        }
+        auto street_id = car.current_street();
+        auto starting_cars = state.starting_cars(street_id);
+        auto is_added = [&](auto car_id) {
+            return !sampling_ || sampled_cars_[car_id];
+        };
 
-void Simulation::initialize_run() {
-    for (auto &&car: cars_) {
-        // Add an event for each car at the start of its path
-        add_event(car, 0);
+        // The whole queue of a street is built when reaching its first car, so that the streets
+        // are seen by adaptive schedules in the same order as when adding the cars one by one
+        if (*std::ranges::find_if(starting_cars, is_added) != car.id()) {
+            continue;
+        }
+        // The sequence number of each initial event is the rank of its car, i.e. the ID by default
+        for (auto car_id: starting_cars | std::views::filter(is_added)) {
+            auto sequence = ranks.empty() ? static_cast<Index>(car_id) : ranks[car_id];
+            auto green_time = enqueue_car(state, state.cars[car_id], 0, sequence);
+            if (green_time.has_value()) {
+                events.emplace_back(*green_time, sequence, static_cast<Index>(street_id));
+            }
+        }
     }
+    state.sequence = static_cast<Index>(state.cars.size());
+    state.event_queue = decltype(state.event_queue){std::greater<>{}, std::move(events)};
 }
 
-void Simulation::add_event(Car &car, unsigned long current_time) {
-    auto street_id = car.current_street();
+template<std::unsigned_integral Index>
+std::optional<Index> Simulation::use_green(RunState<Index> &state, unsigned long street_id, unsigned long current_time) {
     auto intersection_id = city_plan_.streets()[street_id].end().id();
+    auto &&street = state.streets[street_id];
 
     // latest_used_time is the last time the street was used
     // (i.e. the last time a car passed through it)
     // It can be in the future (later that the current time)
-    auto latest_used_time = streets_[street_id].latest_used_time();
+    auto latest_used_time = street.latest_used_time();
 
     // earliest_possible_time is the theoretical next earliest time
     // the street can be used
@@ -179,27 +335,89 @@ void Simulation::add_event(Car &car, unsigned long current_time) {
     if (latest_used_time.has_value()) {
         earliest_possible_time =
             (*latest_used_time >= current_time) ?
-                *latest_used_time + 1 : current_time;
+                *latest_used_time + 1UL : current_time;
     }
 
-    // If there's no schedule for the intersection, don't add the event
+    // If there's no schedule for the intersection, there's no event
     if (!schedules_.contains(intersection_id)) {
-        return;
+        return {};
     }
     auto next_green_time = schedules_.at(intersection_id).next_green(street_id, earliest_possible_time);
 
-    // If the street has no scheduled green light, don't add the event
+    // If the street has no scheduled green light, there's no event
     if (!next_green_time.has_value()) {
-        return;
+        return {};
+    }
+    // Events after the end of the simulation are never processed,
+    // all later times are stored as the end time to keep them within the range of Index
+    if (*next_green_time >= end_time()) {
+        street.set_latest_used_time(static_cast<Index>(end_time()));
+        return {};
     }
-    streets_[street_id].add_car(car.id(), *next_green_time);
-    event_queue_.emplace(*next_green_time, streets_[street_id]);
+    street.set_latest_used_time(static_cast<Index>(*next_green_time));
+    return static_cast<Index>(*next_green_time);
 }
 
-void Simulation::process_event() {
-    auto current_time = event_queue_.top().time();
-    auto &&car = cars_[event_queue_.top().street().get_car()];
-    event_queue_.pop();
+template<std::unsigned_integral Index>
+std::optional<Index> Simulation::enqueue_car(
+    RunState<Index> &state, Car<Index> &car, unsigned long current_time, Index sequence
+) {
+    auto street_id = car.current_street();
+    auto &&street = state.streets[street_id];
+
+    // The car waits in the queue even if it never gets the green light
+    // so that a run resumed from a snapshot with different schedules can still move it
+    street.add_car(static_cast<Index>(car.id()), static_cast<Index>(std::min(current_time, end_time())), sequence);
+    if (!state.queue_stats.empty()) {
+        auto &&stats = state.queue_stats[street_id];
+        ++stats.cars;
+        stats.max_queue = std::max(stats.max_queue, static_cast<unsigned long>(street.queue().size()));
+    }
+
+    // With the street engine, the car behind another one gets its green light when it reaches the front
+    if (engine_ == Engine::STREET && street.queue().size() > 1) {
+        return {};
+    }
+    return use_green(state, street_id, current_time);
+}
+
+template<std::unsigned_integral Index>
+void Simulation::add_event(RunState<Index> &state, Car<Index> &car, unsigned long current_time) {
+    auto sequence = state.sequence++;
+    auto green_time = enqueue_car(state, car, current_time, sequence);
+    if (green_time.has_value()) {
+        state.event_queue.emplace(*green_time, sequence, static_cast<Index>(car.current_street()));
+    }
+}
+
+template<std::unsigned_integral Index>
+void Simulation::process_event(RunState<Index> &state) {
+    auto event = state.event_queue.top();
+    unsigned long current_time = event.time();
+    auto &&street = state.streets[event.street_id()];
+    if (trace_ != nullptr) {
+        auto &&queued_car = street.queue().front();
+        trace_->write({TraceEvent::PASS, queued_car.id, event.street_id(), queued_car.arrival_time, current_time});
+    }
+    if (!state.queue_stats.empty()) {
+        auto &&stats = state.queue_stats[event.street_id()];
+        auto waiting_time = current_time - street.queue().front().arrival_time;
+        stats.waiting_cars += waiting_time > 0;
+        stats.waiting_time += waiting_time;
+    }
+    auto &&car = state.cars[street.get_car()];
+    state.event_queue.pop();
+
+    // With the street engine, the next car in the queue gets its green light after the current one leaves.
+    // Its green light time is the same as if it was computed when the car reached the end of the street,
+    // because the street is used only by the cars in front of it in the meantime.
+    if (engine_ == Engine::STREET && !street.queue().empty()) {
+        auto &&next_car = street.queue().front();
+        auto green_time = use_green(state, event.street_id(), next_car.arrival_time);
+        if (green_time.has_value()) {
+            state.event_queue.emplace(*green_time, next_car.sequence, event.street_id());
+        }
+    }
 
     car.move_to_next_street();
     auto street_id = car.current_street();
@@ -218,45 +436,497 @@ void Simulation::process_event() {
         return;
     }
     // Add event when the car arrives at the end of the street
-    add_event(car, current_time + street_length);
+    add_event(state, car, current_time + street_length);
 }
 
 void Simulation::run() {
+    std::visit([this](auto &state) { run(state); }, run_state_);
+    // A run of only the sampled cars doesn't hold the full run of the schedules
+    if (!sampling_) {
+        run_hash_ = schedules_hash_;
+    }
+}
+
+void Simulation::ensure_run() {
+    if (run_hash_ != schedules_hash_) {
+        run();
+    }
+}
+
+template<std::unsigned_integral Index>
+void Simulation::run(RunState<Index> &state) {
     reset_run();
-    initialize_run();
+    initialize_run(state);
+    run_until(state, end_time());
+}
 
-    while (!event_queue_.empty()) {
-        if (event_queue_.top().time() > city_plan_.duration()) {
+template<std::unsigned_integral Index>
+void Simulation::run_until(RunState<Index> &state, unsigned long time) {
+    auto until = std::min(time, end_time());
+    while (!state.event_queue.empty()) {
+        if (state.event_queue.top().time() >= until) {
             break;
         }
-        process_event();
+        process_event(state);
+    }
+}
+
+void Simulation::set_engine(std::string engine) {
+    std::ranges::transform(engine, engine.begin(), [](auto c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    if (engine == "car") {
+        engine_ = Engine::CAR;
+    }
+    else if (engine == "street") {
+        engine_ = Engine::STREET;
+    }
+    else {
+        throw std::invalid_argument{"Invalid engine option"};
     }
 }
 
 unsigned long Simulation::score() {
+    if (!score_cache_) {
+        run();
+        return total_score_;
+    }
+    if (auto cached_score = score_cache_->find(schedules_hash_); cached_score.has_value()) {
+        return *cached_score;
+    }
     run();
+    score_cache_->insert(schedules_hash_, total_score_);
     return total_score_;
 }
 
-void Simulation::summary() const {
-    unsigned long cars_finished = 0;
-    unsigned long total_driving_time = 0;
-    std::optional<std::reference_wrapper<const Car>> earliest_car;
-    std::optional<std::reference_wrapper<const Car>> latest_car;
-    for (auto &&c: cars_) {
-        if (c.arrival_time()) {
-            ++cars_finished;
-            total_driving_time += *c.arrival_time();
-            if (!earliest_car ||
-                c.arrival_time() < earliest_car->get().arrival_time()) {
-                earliest_car = c;
+unsigned long Simulation::score(unsigned long horizon) {
+    if (horizon >= city_plan_.duration()) {
+        return score();
+    }
+    if (score_cache_) {
+        if (auto cached_score = score_cache_->find(schedules_hash_); cached_score.has_value()) {
+            return *cached_score;
+        }
+    }
+    return std::visit([&](auto &state) {
+        reset_run();
+        initialize_run(state);
+        run_until(state, horizon);
+        return estimate_score(state, horizon);
+    }, run_state_);
+}
+
+template<std::unsigned_integral Index>
+unsigned long Simulation::estimate_score(const RunState<Index> &state, unsigned long horizon) const {
+    auto &&offsets = city_plan_.path_offsets();
+    auto &&remaining_durations = city_plan_.path_remaining_durations();
+    // Free-flow time from the end of the first street of the car to the end of its current street
+    auto free_flow_time = [&](unsigned long car_id, unsigned long path_index) {
+        auto offset = offsets[car_id];
+        return remaining_durations[offset] - remaining_durations[offset + path_index];
+    };
+
+    // The average waiting per traffic light is calibrated by the cars known to the run so far: the arrived ones
+    // and the ones queued at their current traffic lights, each of which waited at all its previous traffic lights
+    double total_waiting = 0;
+    unsigned long traffic_lights = 0;
+    for (auto &&car: state.cars) {
+        if (car.arrival_time().has_value()) {
+            auto path_index = offsets[car.id() + 1] - offsets[car.id()] - 1;
+            total_waiting += static_cast<double>(*car.arrival_time() - free_flow_time(car.id(), path_index));
+            traffic_lights += path_index;
+        }
+    }
+    for (auto &&street: state.streets) {
+        for (auto &&queued_car: street.queue()) {
+            // The arrivals after the end of the simulation are stored as the end time, so they are unknown
+            if (queued_car.arrival_time >= end_time()) {
+                continue;
             }
-            if (!latest_car ||
-                c.arrival_time() > latest_car->get().arrival_time()) {
-                latest_car = c;
+            auto path_index = state.cars[queued_car.id].path_index();
+            total_waiting += static_cast<double>(queued_car.arrival_time - free_flow_time(queued_car.id, path_index));
+            traffic_lights += path_index;
+        }
+    }
+    auto waiting = traffic_lights > 0 ? total_waiting / static_cast<double>(traffic_lights) : 0.0;
+
+    // The cars which passed their last traffic light are already scored; the cars on the way are queued
+    auto duration = static_cast<double>(city_plan_.duration());
+    auto estimate = static_cast<double>(total_score_);
+    for (auto &&street: state.streets) {
+        for (auto &&queued_car: street.queue()) {
+            auto &&car = state.cars[queued_car.id];
+            auto path_index = car.path_index();
+            // Traffic lights after the current one; the last street of the path has none
+            auto later_traffic_lights = offsets[car.id() + 1] - offsets[car.id()] - path_index - 2;
+            // The car passes its current traffic light after the horizon at the earliest
+            auto passing_time = std::max(
+                static_cast<double>(queued_car.arrival_time) + waiting, static_cast<double>(horizon)
+            );
+            auto finish_time = passing_time + static_cast<double>(remaining_durations[offsets[car.id()] + path_index])
+                + waiting * static_cast<double>(later_traffic_lights);
+            if (finish_time <= duration) {
+                estimate += static_cast<double>(city_plan_.bonus()) + duration - finish_time;
             }
         }
     }
+    return static_cast<unsigned long>(std::lround(estimate));
+}
+
+void Simulation::set_car_sample(double fraction, unsigned long seed) {
+    if (!(fraction > 0.0 && fraction <= 1.0)) {
+        throw std::invalid_argument{"Fraction of the sampled cars must be in (0, 1]"};
+    }
+    auto &&cars = city_plan_.cars();
+    auto &&offsets = city_plan_.path_offsets();
+    auto &&remaining_durations = city_plan_.path_remaining_durations();
+    auto path_duration = [&](unsigned long car_id) {
+        return remaining_durations[offsets[car_id]];
+    };
+    auto origin = [&](unsigned long car_id) {
+        return city_plan_.street_ends()[cars[car_id].street_ids().front()];
+    };
+
+    auto samples = std::max(
+        static_cast<unsigned long>(std::lround(fraction * static_cast<double>(cars.size()))), 1UL
+    );
+
+    // Strata of equal sizes by the path durations, ties broken by car IDs;
+    // there are no more strata than samples, so every stratum gets at least one sample
+    std::vector<unsigned long> car_ids(cars.size());
+    std::iota(car_ids.begin(), car_ids.end(), 0UL);
+    std::ranges::sort(car_ids, {}, [&](auto car_id) {
+        return std::pair{path_duration(car_id), car_id};
+    });
+    auto strata = std::min(CAR_SAMPLE_STRATA, samples);
+    car_strata_.assign(cars.size(), 0);
+    stratum_sizes_.assign(strata, 0);
+    for (size_t rank = 0; rank < car_ids.size(); ++rank) {
+        auto stratum = rank * strata / car_ids.size();
+        car_strata_[car_ids[rank]] = stratum;
+        ++stratum_sizes_[stratum];
+    }
+
+    // Systematic sampling of the cars ordered by strata and origins
+    std::ranges::sort(car_ids, {}, [&](auto car_id) {
+        return std::tuple{car_strata_[car_id], origin(car_id), path_duration(car_id), car_id};
+    });
+    auto step = static_cast<double>(cars.size()) / static_cast<double>(samples);
+    std::seed_seq seed_sequence{seed};
+    std::mt19937_64 random_engine{seed_sequence};
+    auto offset = std::uniform_real_distribution<double>{0.0, step}(random_engine);
+    sampled_cars_.assign(cars.size(), false);
+    for (unsigned long i = 0; i < samples && !car_ids.empty(); ++i) {
+        auto index = std::min(static_cast<size_t>(offset + static_cast<double>(i) * step), car_ids.size() - 1);
+        sampled_cars_[car_ids[index]] = true;
+    }
+}
+
+void Simulation::clear_car_sample() {
+    sampled_cars_.clear();
+    car_strata_.clear();
+    stratum_sizes_.clear();
+}
+
+std::vector<unsigned long> Simulation::car_sample() const {
+    std::vector<unsigned long> car_ids;
+    for (unsigned long car_id = 0; car_id < sampled_cars_.size(); ++car_id) {
+        if (sampled_cars_[car_id]) {
+            car_ids.push_back(car_id);
+        }
+    }
+    return car_ids;
+}
+
+SampledScore Simulation::sampled_score() {
+    if (sampled_cars_.empty()) {
+        throw std::runtime_error{"No car sample is set"};
+    }
+    sampling_ = true;
+    try {
+        run();
+    }
+    catch (...) {
+        sampling_ = false;
+        throw;
+    }
+    sampling_ = false;
+
+    // Sum and sum of squares of the scores of the sampled cars of each stratum
+    std::vector<unsigned long> samples(stratum_sizes_.size());
+    std::vector<double> sums(stratum_sizes_.size()), squares(stratum_sizes_.size());
+    std::visit([&](auto &state) {
+        for (auto &&car: state.cars) {
+            if (!sampled_cars_[car.id()]) {
+                continue;
+            }
+            auto stratum = car_strata_[car.id()];
+            auto score = static_cast<double>(car.score());
+            ++samples[stratum];
+            sums[stratum] += score;
+            squares[stratum] += score * score;
+        }
+    }, run_state_);
+
+    SampledScore result;
+    result.score = total_score_;
+    double estimate = 0;
+    double variance = 0;
+    for (size_t stratum = 0; stratum < stratum_sizes_.size(); ++stratum) {
+        auto n = static_cast<double>(samples[stratum]);
+        auto size = static_cast<double>(stratum_sizes_[stratum]);
+        result.cars += samples[stratum];
+        if (samples[stratum] == 0) {
+            continue;
+        }
+        auto mean = sums[stratum] / n;
+        estimate += size * mean;
+        if (samples[stratum] > 1) {
+            // Sample variance of the stratum with the finite population correction
+            auto sample_variance = std::max((squares[stratum] - n * mean * mean) / (n - 1), 0.0);
+            variance += size * size * (1 - n / size) * sample_variance / n;
+        }
+    }
+    result.estimate = static_cast<unsigned long>(std::lround(estimate));
+    result.error = std::sqrt(variance);
+    return result;
+}
+
+unsigned long Simulation::trace(const std::string &filename) {
+    TraceWriter writer{filename, {city_plan_.duration(), city_plan_.streets().size(), city_plan_.cars().size()}};
+    trace_ = &writer;
+    try {
+        run();
+    }
+    catch (...) {
+        trace_ = nullptr;
+        throw;
+    }
+    trace_ = nullptr;
+
+    // The cars still waiting at the end of the run are recorded in the order of the streets
+    std::visit([&](auto &state) {
+        for (unsigned long street_id = 0; street_id < state.streets.size(); ++street_id) {
+            for (auto &&queued_car: state.streets[street_id].queue()) {
+                writer.write({TraceEvent::WAITING, queued_car.id, street_id, queued_car.arrival_time, end_time()});
+            }
+        }
+    }, run_state_);
+    writer.close();
+    return total_score_;
+}
+
+Snapshot Simulation::snapshot(unsigned long time) {
+    return std::visit([&](auto &state) {
+        reset_run();
+        initialize_run(state);
+        run_until(state, time);
+        return capture(state, time);
+    }, run_state_);
+}
+
+template<std::unsigned_integral Index>
+Snapshot Simulation::capture(const RunState<Index> &state, unsigned long time) const {
+    Snapshot snapshot;
+    snapshot.time = time;
+    snapshot.score = total_score_;
+    snapshot.sequence = state.sequence;
+
+    snapshot.path_indices.reserve(state.cars.size());
+    snapshot.arrival_times.reserve(state.cars.size());
+    for (auto &&car: state.cars) {
+        snapshot.path_indices.push_back(car.path_index());
+        snapshot.arrival_times.push_back(car.arrival_time());
+    }
+
+    snapshot.queue_offsets.reserve(state.streets.size() + 1);
+    snapshot.queue_offsets.push_back(0);
+    for (auto &&street: state.streets) {
+        for (auto &&[car_id, arrival_time, sequence]: street.queue()) {
+            snapshot.queued_cars.push_back({car_id, arrival_time, sequence});
+        }
+        snapshot.queue_offsets.push_back(snapshot.queued_cars.size());
+    }
+    return snapshot;
+}
+
+unsigned long Simulation::resume(const Snapshot &snapshot) {
+    std::visit([&](auto &state) {
+        restore(state, snapshot);
+        run_until(state, end_time());
+    }, run_state_);
+    return total_score_;
+}
+
+template<std::unsigned_integral Index>
+void Simulation::restore(RunState<Index> &state, const Snapshot &snapshot) {
+    if (snapshot.path_indices.size() != state.cars.size()
+        || snapshot.queue_offsets.size() != state.streets.size() + 1) {
+        throw std::invalid_argument{"Snapshot does not match the city plan of the simulation"};
+    }
+    reset_run();
+    total_score_ = snapshot.score;
+    state.sequence = static_cast<Index>(snapshot.sequence);
+
+    for (size_t i = 0; i < state.cars.size(); ++i) {
+        state.cars[i].restore(
+            snapshot.path_indices[i], snapshot.arrival_times[i], city_plan_.duration(), city_plan_.bonus()
+        );
+    }
+
+    std::vector<StreetEvent<Index>> events;
+    events.reserve(snapshot.queued_cars.size());
+    std::span<const QueuedCar<unsigned long>> queued_cars{snapshot.queued_cars};
+    for (auto &&street: state.streets) {
+        auto offset = snapshot.queue_offsets[street.id()];
+        auto queue = queued_cars.subspan(offset, snapshot.queue_offsets[street.id() + 1] - offset);
+        street.restore(queue);
+
+        auto intersection_id = city_plan_.streets()[street.id()].end().id();
+        if (queue.empty() || !schedules_.contains(intersection_id)) {
+            continue;
+        }
+        auto &&schedule = schedules_.at(intersection_id);
+
+        // Green light times of the waiting cars are computed again using the current schedules.
+        // None of the waiting cars could get the green light before the snapshot time,
+        // otherwise they would have already left the street.
+        std::optional<unsigned long> latest_used_time;
+        for (auto &&queued_car: queue) {
+            auto earliest_possible_time = std::max(queued_car.arrival_time, snapshot.time);
+            if (latest_used_time.has_value()) {
+                earliest_possible_time = std::max(earliest_possible_time, *latest_used_time + 1);
+            }
+            auto next_green_time = schedule.next_green(street.id(), earliest_possible_time);
+
+            // If the street has no scheduled green light, none of the cars can leave
+            if (!next_green_time.has_value()) {
+                break;
+            }
+            // Neither this car nor the cars behind it can leave before the end of the simulation
+            if (*next_green_time >= end_time()) {
+                latest_used_time = end_time();
+                break;
+            }
+            latest_used_time = next_green_time;
+            // The original sequence number keeps the tie-breaking of the original run
+            events.emplace_back(
+                static_cast<Index>(*next_green_time), static_cast<Index>(queued_car.sequence),
+                static_cast<Index>(street.id())
+            );
+            // With the street engine, only the first car in the queue has an event
+            if (engine_ == Engine::STREET) {
+                break;
+            }
+        }
+        if (latest_used_time.has_value()) {
+            street.set_latest_used_time(static_cast<Index>(*latest_used_time));
+        }
+    }
+    // Building the heap at once is cheaper than pushing the events of all waiting cars one by one
+    state.event_queue = decltype(state.event_queue){std::greater<>{}, std::move(events)};
+}
+
+std::pair<unsigned long, unsigned long> Simulation::optimize_rotation(unsigned long intersection_id) {
+    if (!schedules_.contains(intersection_id)) {
+        throw std::invalid_argument{"Intersection has no schedule"};
+    }
+    auto &&schedule = schedules_.at(intersection_id);
+    auto order = schedule.order();
+    auto times = schedule.times();
+    bool was_dirty = dirty_[intersection_id];
+
+    // The schedule of the intersection doesn't affect the run before the first car reaches its traffic light,
+    // so the run of the current schedules is paused then and every rotation resumes it
+    auto snapshot = std::visit([&](auto &state) {
+        reset_run();
+        initialize_run(state);
+        auto first_arrival = end_time();
+        for (auto &&street: city_plan_.intersections()[intersection_id].streets()) {
+            if (!state.streets[street.get().id()].queue().empty()) {
+                first_arrival = 0;
+            }
+        }
+        // All events before the first arrival are at other intersections, so the run is the same for every rotation
+        while (!state.event_queue.empty() && state.event_queue.top().time() < first_arrival) {
+            auto event = state.event_queue.top();
+            auto &&car = state.cars[state.streets[event.street_id()].queue().front().id];
+            process_event(state);
+            auto &&street = city_plan_.streets()[car.current_street()];
+            if (!car.final_destination() && street.end().id() == intersection_id) {
+                first_arrival = std::min(first_arrival, event.time() + street.length());
+            }
+        }
+        return capture(state, first_arrival);
+    }, run_state_);
+
+    auto rotated = [&](const std::vector<unsigned long> &values, unsigned long rotation) {
+        std::vector<unsigned long> result(values.size());
+        std::ranges::rotate_copy(values, values.begin() + static_cast<std::ptrdiff_t>(rotation), result.begin());
+        return result;
+    };
+
+    std::pair<unsigned long, unsigned long> best{0, 0};
+    for (unsigned long rotation = 0; rotation < std::max(order.size(), 1UL); ++rotation) {
+        if (rotation > 0) {
+            set_schedule(schedule, rotated(order, rotation), rotated(times, rotation));
+        }
+        // Restoring the snapshot at time zero costs more than starting the run from scratch
+        if (snapshot.time == 0) {
+            run();
+        }
+        else {
+            resume(snapshot);
+        }
+        if (rotation == 0 || total_score_ > best.second) {
+            best = {rotation, total_score_};
+        }
+    }
+    if (best.first != 0) {
+        set_schedule(schedule, rotated(order, best.first), rotated(times, best.first));
+    }
+    else if (order.size() > 1) {
+        // The original schedule is kept, so the intersection is only dirty if it already was
+        set_schedule(schedule, std::move(order), std::move(times));
+        if (!was_dirty) {
+            dirty_[intersection_id] = false;
+            std::erase(dirty_intersections_, intersection_id);
+        }
+    }
+    return best;
+}
+
+void Simulation::summary() {
+    /** Car that arrived at its destination. */
+    struct ArrivedCar {
+        unsigned long id;
+        unsigned long arrival_time;
+        unsigned long score;
+    };
+
+    unsigned long cars_finished = 0;
+    unsigned long total_driving_time = 0;
+    std::optional<ArrivedCar> earliest_car;
+    std::optional<ArrivedCar> latest_car;
+    ensure_run();
+    std::visit([&](auto &&state) {
+        for (auto &&c: state.cars) {
+            if (c.arrival_time()) {
+                ArrivedCar car{c.id(), *c.arrival_time(), c.score()};
+                ++cars_finished;
+                total_driving_time += car.arrival_time;
+                if (!earliest_car ||
+                    car.arrival_time < earliest_car->arrival_time) {
+                    earliest_car = car;
+                }
+                if (!latest_car ||
+                    car.arrival_time > latest_car->arrival_time) {
+                    latest_car = car;
+                }
+            }
+        }
+    }, run_state_);
 
     double total_cycle_duration = 0;
     // All streets with a scheduled green light
@@ -296,13 +966,13 @@ void Simulation::summary() const {
         auto average_drive_time_ = static_cast<double>(total_driving_time) / cars_finished;
 
         std::cout
-            << "The earliest car (ID " << earliest_car->get().id()
+            << "The earliest car (ID " << earliest_car->id
             << ") arrived at its destination after "
-            << *earliest_car->get().arrival_time() << " seconds scoring "
-            << earliest_car->get().score() << " points, whereas the last car (ID "
-            << latest_car->get().id() << ") arrived at its destination after "
-            << *latest_car->get().arrival_time() << " seconds scoring "
-            << latest_car->get().score() << " points. "
+            << earliest_car->arrival_time << " seconds scoring "
+            << earliest_car->score << " points, whereas the last car (ID "
+            << latest_car->id << ") arrived at its destination after "
+            << latest_car->arrival_time << " seconds scoring "
+            << latest_car->score << " points. "
             << "Cars that arrived within the deadline drove for an average of "
             << average_drive_time_ << " seconds to arrive at their destination.";
 
@@ -362,7 +1032,48 @@ void Simulation::set_non_trivial_schedules(
             });
             order = {street_ids.begin(), street_ids.end()};
         }
-        schedules_.at(intersection.id()).set(std::move(order), std::move(times));
+        auto &&schedule = schedules_.at(intersection.id());
+        // Most schedules stay the same when only a few intersections are changed (e.g. by local search)
+        if (schedule.order() == order && schedule.times() == times) {
+            continue;
+        }
+        set_schedule(schedule, std::move(order), std::move(times));
+    }
+}
+
+void Simulation::update_schedules(
+    const std::vector<unsigned long> &indices, const std::vector<std::vector<unsigned long>> &orders,
+    const std::vector<std::vector<unsigned long>> &times, bool relative_order
+) {
+    if (orders.size() != indices.size() || times.size() != indices.size()) {
+        throw std::invalid_argument{"Indices, orders and times must have the same size"};
+    }
+    // All schedules are validated first, so that an invalid one doesn't leave the others half applied
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] >= non_trivial_ids_.size() || orders[i].size() != times[i].size()) {
+            throw std::invalid_argument{"Invalid index or schedule of a non-trivial intersection"};
+        }
+        auto &&used_streets = city_plan_.intersections()[non_trivial_ids_[indices[i]]].used_streets();
+        auto invalid_index = [&](auto index) { return index >= used_streets.size(); };
+        if (relative_order && std::ranges::any_of(orders[i], invalid_index)) {
+            throw std::invalid_argument{"Invalid index or schedule of a non-trivial intersection"};
+        }
+    }
+    for (size_t i = 0; i < indices.size(); ++i) {
+        auto intersection_id = non_trivial_ids_[indices[i]];
+        auto &&schedule = schedules_.at(intersection_id);
+        auto &&used_streets = city_plan_.intersections()[intersection_id].used_streets();
+        auto street_ids = orders[i] | std::views::transform([&](unsigned long street) {
+            return relative_order ? static_cast<const city_plan::Street &>(used_streets[street]).id() : street;
+        });
+        // Like `set_non_trivial_schedules`, unchanged schedules are neither marked as changed nor rehashed
+        if (std::ranges::equal(street_ids, schedule.order()) && times[i] == schedule.times()) {
+            continue;
+        }
+        schedules_hash_ ^= schedule.hash();
+        schedule.assign(orders[i], times[i], relative_order);
+        schedules_hash_ ^= schedule.hash();
+        mark_dirty(intersection_id);
     }
 }
 
@@ -379,4 +1090,276 @@ Simulation adaptive_simulation(const city_plan::CityPlan &city_plan) {
     s.adaptive_schedules();
     return s;
 }
+
+void validate_non_trivial_schedules(
+    const city_plan::CityPlan &city_plan,
+    const std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>> &schedules,
+    bool relative_order
+) {
+    auto non_trivial_intersections = city_plan.non_trivial_intersections();
+    auto intersection = non_trivial_intersections.begin();
+    for (auto &&[order, times]: schedules) {
+        if (intersection == non_trivial_intersections.end()) {
+            throw std::invalid_argument{"Too many schedules"};
+        }
+        if (order.size() != times.size()) {
+            throw std::invalid_argument{"Order and times of a schedule must have the same size"};
+        }
+        auto limit = relative_order ? intersection->used_streets().size() : city_plan.streets().size();
+        if (std::ranges::any_of(order, [&](auto street) { return street >= limit; })) {
+            throw std::invalid_argument{"Invalid street in the schedule order"};
+        }
+        ++intersection;
+    }
+    if (intersection != non_trivial_intersections.end()) {
+        throw std::invalid_argument{"Too few schedules"};
+    }
+}
+
+Comparison Simulation::compare(
+    const std::vector<unsigned long> &indices, const std::vector<std::vector<unsigned long>> &orders,
+    const std::vector<std::vector<unsigned long>> &times, bool relative_order
+) {
+    if (orders.size() != indices.size() || times.size() != indices.size()) {
+        throw std::invalid_argument{"Indices, orders and times must have the same size"};
+    }
+    if (std::ranges::any_of(indices, [&](auto index) { return index >= non_trivial_ids_.size(); })) {
+        throw std::invalid_argument{"Invalid index or schedule of a non-trivial intersection"};
+    }
+
+    if (earliest_arrivals_.empty()) {
+        compute_earliest_arrivals();
+    }
+    if (!compared_run_.has_value() || compared_run_->schedules_hash != schedules_hash_) {
+        record_compared_run();
+    }
+
+    // The other schedules don't affect the run before any car can reach one of the changed intersections,
+    // so the other run is resumed from the latest snapshot before that time
+    auto divergence_time = end_time();
+    for (auto index: indices) {
+        divergence_time = std::min(divergence_time, earliest_arrivals_[index]);
+    }
+    auto &&snapshots = compared_run_->snapshots;
+    auto snapshot = std::ranges::upper_bound(snapshots, divergence_time, {}, &Snapshot::time);
+    auto &&resumed_snapshot = *std::prev(snapshot);
+
+    // The current schedules are restored from copies, and the intersections marked as changed
+    // by the other schedules are unmarked unless they were already marked before
+    std::vector<std::vector<unsigned long>> current_orders;
+    std::vector<std::vector<unsigned long>> current_times;
+    current_orders.reserve(indices.size());
+    current_times.reserve(indices.size());
+    for (auto index: indices) {
+        auto &&schedule = schedules_.at(non_trivial_ids_[index]);
+        current_orders.push_back(schedule.order());
+        current_times.push_back(schedule.times());
+    }
+    auto dirty_count = dirty_intersections_.size();
+    auto restore_schedules = [&] {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            auto &&schedule = schedules_.at(non_trivial_ids_[indices[i]]);
+            schedules_hash_ ^= schedule.hash();
+            schedule.assign(current_orders[i], current_times[i]);
+            schedules_hash_ ^= schedule.hash();
+        }
+        for (auto id: std::span{dirty_intersections_}.subspan(dirty_count)) {
+            dirty_[id] = false;
+        }
+        dirty_intersections_.resize(dirty_count);
+    };
+
+    try {
+        update_schedules(indices, orders, times, relative_order);
+        // Restoring the snapshot at time zero costs more than starting the run from scratch
+        if (resumed_snapshot.time == 0) {
+            run();
+        }
+        else {
+            resume(resumed_snapshot);
+        }
+    }
+    catch (...) {
+        restore_schedules();
+        throw;
+    }
+    restore_schedules();
+
+    Comparison comparison;
+    comparison.score = compared_run_->score;
+    comparison.other_score = total_score_;
+    comparison.score_delta = static_cast<long>(total_score_) - static_cast<long>(compared_run_->score);
+
+    auto score = [&](std::optional<unsigned long> arrival_time) {
+        return arrival_time.has_value() ?
+            static_cast<long>(city_plan_.bonus() + city_plan_.duration() - *arrival_time) : 0L;
+    };
+    auto other_arrival_times = arrival_times();
+    for (unsigned long car_id = 0; car_id < other_arrival_times.size(); ++car_id) {
+        auto arrival_time = compared_run_->arrival_times[car_id];
+        auto other_arrival_time = other_arrival_times[car_id];
+        if (arrival_time != other_arrival_time) {
+            comparison.cars.push_back({
+                car_id, arrival_time, other_arrival_time, score(other_arrival_time) - score(arrival_time)
+            });
+        }
+    }
+    return comparison;
+}
+
+void Simulation::compute_earliest_arrivals() {
+    auto &&offsets = city_plan_.path_offsets();
+    auto &&street_ids = city_plan_.path_street_ids();
+    auto &&street_ends = city_plan_.street_ends();
+    auto &&street_lengths = city_plan_.street_lengths();
+
+    // Same times as `CityPlan::earliest_arrival()`, computed for all intersections in one pass over the paths
+    std::vector<unsigned long> earliest_arrivals(city_plan_.intersections().size(), end_time());
+    for (unsigned long car_id = 0; car_id + 1 < offsets.size(); ++car_id) {
+        unsigned long time = 0;
+        // Cars on the last street of their path don't wait at the traffic light
+        for (auto i = offsets[car_id]; i + 1 < offsets[car_id + 1]; ++i) {
+            // The car starts at the end of the first street
+            if (i > offsets[car_id]) {
+                time += street_lengths[street_ids[i]];
+            }
+            auto &&earliest_arrival = earliest_arrivals[street_ends[street_ids[i]]];
+            earliest_arrival = std::min(earliest_arrival, time);
+        }
+    }
+    earliest_arrivals_.clear();
+    earliest_arrivals_.reserve(non_trivial_ids_.size());
+    for (auto id: non_trivial_ids_) {
+        earliest_arrivals_.push_back(earliest_arrivals[id]);
+    }
+}
+
+void Simulation::record_compared_run() {
+    // Snapshots evenly spaced until the latest time the first car can reach any of the intersections
+    unsigned long latest_arrival = 0;
+    for (auto earliest_arrival: earliest_arrivals_) {
+        if (earliest_arrival < end_time()) {
+            latest_arrival = std::max(latest_arrival, earliest_arrival);
+        }
+    }
+    std::vector<Snapshot> snapshots;
+    std::visit([&](auto &state) {
+        reset_run();
+        initialize_run(state);
+        // The snapshots are captured on the way, so the run is simulated only once
+        for (unsigned long i = 0; i < COMPARE_SNAPSHOTS; ++i) {
+            auto time = latest_arrival * i / COMPARE_SNAPSHOTS;
+            if (!snapshots.empty() && snapshots.back().time == time) {
+                continue;
+            }
+            run_until(state, time);
+            snapshots.push_back(capture(state, time));
+        }
+        run_until(state, end_time());
+    }, run_state_);
+    run_hash_ = schedules_hash_;
+    compared_run_ = ComparedRun{schedules_hash_, total_score_, arrival_times(), std::move(snapshots)};
+}
+
+std::vector<std::optional<unsigned long>> Simulation::arrival_times() const {
+    return std::visit([](auto &state) {
+        std::vector<std::optional<unsigned long>> arrival_times;
+        arrival_times.reserve(state.cars.size());
+        for (auto &&car: state.cars) {
+            auto arrival_time = car.arrival_time();
+            arrival_times.push_back(
+                arrival_time.has_value() ? std::optional<unsigned long>{*arrival_time} : std::nullopt
+            );
+        }
+        return arrival_times;
+    }, run_state_);
+}
+
+std::vector<QueueStats> Simulation::queue_stats() {
+    auto collected = std::visit([](auto &state) { return !state.queue_stats.empty(); }, run_state_);
+    if (run_hash_ != schedules_hash_ || !collected) {
+        collecting_queue_stats_ = true;
+        try {
+            run();
+        }
+        catch (...) {
+            collecting_queue_stats_ = false;
+            throw;
+        }
+        collecting_queue_stats_ = false;
+    }
+    return std::visit([this](auto &state) {
+        auto stats = state.queue_stats;
+        // The cars still waiting at the end of the run wait until the end
+        for (auto &&street: state.streets) {
+            for (auto &&queued_car: street.queue()) {
+                stats[street.id()].waiting_cars += end_time() > queued_car.arrival_time;
+                stats[street.id()].waiting_time += end_time() - queued_car.arrival_time;
+            }
+        }
+        return stats;
+    }, run_state_);
+}
+
+void Simulation::rebalance_times(std::optional<unsigned long> cycle) {
+    if (cycle.has_value() && *cycle == 0) {
+        throw std::invalid_argument{"Cycle length must be positive"};
+    }
+    auto stats = queue_stats();
+
+    std::vector<unsigned long> demands;
+    std::vector<unsigned long> remainders;
+    std::vector<unsigned long> positions;
+    for (auto id: non_trivial_ids_) {
+        auto &&schedule = schedules_.at(id);
+        auto &&order = schedule.order();
+        if (order.empty()) {
+            continue;
+        }
+
+        // The streets reached by a car keep one second for the cars passing without waiting, the others get none
+        std::vector<unsigned long> times(order.size());
+        demands.clear();
+        for (size_t i = 0; i < order.size(); ++i) {
+            times[i] = stats[order[i]].cars > 0;
+            demands.push_back(stats[order[i]].waiting_cars);
+        }
+        auto used_streets = std::accumulate(times.begin(), times.end(), 0UL);
+        if (used_streets == 0) {
+            if (!cycle.has_value()) {
+                continue;
+            }
+            // Without any car, the target cycle is split evenly
+            std::ranges::fill(times, 1UL);
+            used_streets = times.size();
+        }
+        auto total_demand = std::accumulate(demands.begin(), demands.end(), 0UL);
+        if (total_demand == 0) {
+            // Without any waiting car, the spare seconds go evenly to the used streets
+            demands = times;
+            total_demand = used_streets;
+        }
+
+        // The spare seconds are split in proportion to the numbers of waiting cars
+        auto spare = std::max(cycle.value_or(schedule.duration()), used_streets) - used_streets;
+        remainders.resize(order.size());
+        auto left = spare;
+        for (size_t i = 0; i < order.size(); ++i) {
+            times[i] += spare * demands[i] / total_demand;
+            remainders[i] = spare * demands[i] % total_demand;
+            left -= spare * demands[i] / total_demand;
+        }
+        // The seconds lost by rounding down go to the largest remainders, ties to the earlier streets
+        positions.resize(order.size());
+        std::iota(positions.begin(), positions.end(), 0UL);
+        std::ranges::stable_sort(positions, std::greater{}, [&](auto i) { return remainders[i]; });
+        for (size_t i = 0; i < left; ++i) {
+            ++times[positions[i]];
+        }
+
+        if (times != schedule.times()) {
+            set_schedule(schedule, std::vector<unsigned long>{order}, std::move(times));
+        }
+    }
+}
 }
@@ -0,0 +1,88 @@
+#include <stdexcept>
+
+#include "simulation/simulation_pool.hpp"
+
+namespace simulation {
+
+Simulation &SimulationPool::Lease::simulation() const {
+    if (simulation_ == nullptr) {
+        throw std::logic_error{"Simulation lease was already released"};
+    }
+    return *simulation_;
+}
+
+void SimulationPool::Lease::release() {
+    if (simulation_ != nullptr) {
+        pool_->release(*simulation_);
+        pool_ = nullptr;
+        simulation_ = nullptr;
+    }
+}
+
+SimulationPool::SimulationPool(
+    const city_plan::CityPlan &city_plan, unsigned long max_replicas, std::shared_ptr<ScoreCache> cache
+) : template_([&] {
+        auto simulation = default_simulation(city_plan);
+        simulation.set_score_cache(std::move(cache));
+        return simulation;
+    }()),
+    max_replicas_(max_replicas) {
+    if (max_replicas == 0) {
+        throw std::invalid_argument{"Simulation pool needs at least one replica"};
+    }
+    replicas_.reserve(max_replicas);
+    idle_.reserve(max_replicas);
+}
+
+SimulationPool::Lease SimulationPool::acquire() {
+    {
+        std::unique_lock lock{mutex_};
+        released_.wait(lock, [this] {
+            return !idle_.empty() || replicas_.size() + cloning_ < max_replicas_;
+        });
+        if (!idle_.empty()) {
+            auto simulation = idle_.back();
+            idle_.pop_back();
+            return {*this, *simulation};
+        }
+        ++cloning_;
+    }
+
+    // The template is never modified, so the replicas can be cloned concurrently outside the lock
+    std::unique_ptr<Simulation> replica;
+    try {
+        replica = std::make_unique<Simulation>(template_);
+    }
+    catch (...) {
+        {
+            std::scoped_lock lock{mutex_};
+            --cloning_;
+        }
+        released_.notify_one();
+        throw;
+    }
+
+    std::scoped_lock lock{mutex_};
+    --cloning_;
+    auto &&simulation = *replicas_.emplace_back(std::move(replica));
+    return {*this, simulation};
+}
+
+unsigned long SimulationPool::replicas() const {
+    std::scoped_lock lock{mutex_};
+    return replicas_.size();
+}
+
+unsigned long SimulationPool::available() const {
+    std::scoped_lock lock{mutex_};
+    return idle_.size() + (max_replicas_ - replicas_.size() - cloning_);
+}
+
+void SimulationPool::release(Simulation &simulation) {
+    {
+        std::scoped_lock lock{mutex_};
+        idle_.push_back(&simulation);
+    }
+    released_.notify_one();
+}
+}
@@ -0,0 +1,94 @@
+#include <stdexcept>
+#include <string_view>
+
+#include "simulation/trace.hpp"
+
+namespace simulation {
+
+namespace {
+    /** Magic bytes at the beginning of every trace file, including the format version. */
+    constexpr std::string_view MAGIC = "TSTRACE1";
+}
+
+TraceWriter::TraceWriter(const std::string &filename, const TraceHeader &header)
+    : filename_(filename), file_(filename, std::ios::binary) {
+    if (!file_.is_open()) {
+        throw std::runtime_error{"Could not open file " + filename};
+    }
+    buffer_.reserve(FLUSH_SIZE + 64);
+    buffer_.insert(buffer_.end(), MAGIC.begin(), MAGIC.end());
+    put(header.duration);
+    put(header.streets);
+    put(header.cars);
+}
+
+TraceWriter::~TraceWriter() {
+    try {
+        flush();
+    }
+    catch (...) {
+        // Destructors must not throw, the error is reported by close()
+    }
+}
+
+void TraceWriter::flush() {
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+void TraceWriter::close() {
+    flush();
+    file_.close();
+    if (file_.fail()) {
+        throw std::runtime_error{"Could not write file " + filename_};
+    }
+}
+
+TraceReader::TraceReader(const std::string &filename)
+    : filename_(filename), file_(filename, std::ios::binary) {
+    if (!file_.is_open()) {
+        throw std::runtime_error{"Could not open file " + filename};
+    }
+    std::string magic(MAGIC.size(), '\0');
+    file_.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+    if (magic != MAGIC) {
+        throw std::runtime_error{"File " + filename + " is not an event trace"};
+    }
+    header_.duration = get();
+    header_.streets = get();
+    header_.cars = get();
+}
+
+std::optional<TraceRecord> TraceReader::next() {
+    auto event = file_.get();
+    if (event == std::ifstream::traits_type::eof()) {
+        return {};
+    }
+    if (event != static_cast<int>(TraceEvent::PASS) && event != static_cast<int>(TraceEvent::WAITING)) {
+        throw std::runtime_error{"Invalid record in event trace " + filename_};
+    }
+    TraceRecord record{};
+    record.event = static_cast<TraceEvent>(event);
+    record.car_id = get();
+    record.street_id = get();
+    record.time = previous_time_ + get();
+    record.arrival_time = record.time - get();
+    previous_time_ = record.time;
+    return record;
+}
+
+std::uint64_t TraceReader::get() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        auto byte = file_.get();
+        if (byte == std::ifstream::traits_type::eof()) {
+            throw std::runtime_error{"Truncated event trace " + filename_};
+        }
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error{"Invalid number in event trace " + filename_};
+}
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "simulation/trace.hpp"
+
+namespace {
+    /** Statistics of the queue of one street rebuilt from the trace. */
+    struct StreetStats {
+        /** Number of cars that got the green light. */
+        unsigned long passes{};
+        /** Number of cars still waiting at the end of the simulation. */
+        unsigned long waiting{};
+        /** Total time the cars spent in the queue. */
+        unsigned long total_wait{};
+        /** Longest queue. */
+        unsigned long max_queue{};
+    };
+
+    /**
+     * Return the queue lengths of a street as `(time, length)` pairs, one pair for each time the length changes.
+     *
+     * @param intervals `(arrival_time, time)` pairs of the cars that waited in the queue.
+     */
+    std::vector<std::pair<unsigned long, long>> queue_timeline(
+        const std::vector<std::pair<unsigned long, unsigned long>> &intervals
+    ) {
+        // A car joins the queue at its arrival and leaves it at its green light
+        std::vector<std::pair<unsigned long, long>> changes;
+        changes.reserve(2 * intervals.size());
+        for (auto &&[arrival_time, time]: intervals) {
+            changes.emplace_back(arrival_time, 1);
+            changes.emplace_back(time, -1);
+        }
+        std::ranges::sort(changes);
+
+        std::vector<std::pair<unsigned long, long>> timeline;
+        long length = 0;
+        for (unsigned long i = 0; i < changes.size(); ++i) {
+            length += changes[i].second;
+            // Cars passing at their arrival time don't change the length
+            auto last_change = i + 1 == changes.size() || changes[i + 1].first != changes[i].first;
+            auto previous_length = timeline.empty() ? 0 : timeline.back().second;
+            if (last_change && length != previous_length) {
+                timeline.emplace_back(changes[i].first, length);
+            }
+        }
+        return timeline;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    if (args.empty()) {
+        std::cerr << "Usage: replay_trace TRACE [STREET_ID]...\n\n"
+                  << "Print a summary of the event trace and the queue lengths over time of the given streets.\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        simulation::TraceReader reader{args[0]};
+        auto &&header = reader.header();
+
+        std::vector<unsigned long> timeline_streets;
+        for (unsigned long i = 1; i < args.size(); ++i) {
+            auto street_id = std::stoul(args[i]);
+            if (street_id >= header.streets) {
+                std::cerr << "Invalid street ID " << street_id << "\n";
+                return EXIT_FAILURE;
+            }
+            timeline_streets.push_back(street_id);
+        }
+
+        // The queues are rebuilt from the waiting intervals of the cars, without running the simulation
+        std::vector<StreetStats> streets(header.streets);
+        std::vector<std::vector<std::pair<unsigned long, unsigned long>>> intervals(header.streets);
+        unsigned long records = 0;
+        while (auto record = reader.next()) {
+            ++records;
+            auto &&stats = streets.at(record->street_id);
+            if (record->event == simulation::TraceEvent::PASS) {
+                ++stats.passes;
+            }
+            else {
+                ++stats.waiting;
+            }
+            stats.total_wait += record->time - record->arrival_time;
+            intervals[record->street_id].emplace_back(record->arrival_time, record->time);
+        }
+
+        unsigned long passes = 0;
+        unsigned long waiting = 0;
+        for (unsigned long street_id = 0; street_id < header.streets; ++street_id) {
+            auto &&stats = streets[street_id];
+            passes += stats.passes;
+            waiting += stats.waiting;
+            for (auto &&[time, length]: queue_timeline(intervals[street_id])) {
+                stats.max_queue = std::max(stats.max_queue, static_cast<unsigned long>(length));
+            }
+        }
+
+        std::cout << "Duration: " << header.duration << " s\n"
+                  << "Streets: " << header.streets << "\n"
+                  << "Cars: " << header.cars << "\n"
+                  << "Records: " << records << "\n"
+                  << "Green lights used: " << passes << "\n"
+                  << "Cars waiting at the end: " << waiting << "\n";
+
+        std::vector<unsigned long> congested(header.streets);
+        for (unsigned long street_id = 0; street_id < header.streets; ++street_id) {
+            congested[street_id] = street_id;
+        }
+        auto top = std::min(congested.size(), 10UL);
+        std::ranges::partial_sort(congested, congested.begin() + static_cast<long>(top), [&](auto a, auto b) {
+            return std::pair{streets[a].max_queue, streets[a].total_wait} > std::pair{streets[b].max_queue, streets[b].total_wait};
+        });
+        std::cout << "\nMost congested streets:\n"
+                  << std::setw(10) << "street" << std::setw(12) << "max queue" << std::setw(14) << "total wait"
+                  << std::setw(10) << "passes" << std::setw(10) << "waiting" << "\n";
+        for (unsigned long i = 0; i < top && streets[congested[i]].max_queue > 0; ++i) {
+            auto &&stats = streets[congested[i]];
+            std::cout << std::setw(10) << congested[i] << std::setw(12) << stats.max_queue
+                      << std::setw(14) << stats.total_wait << std::setw(10) << stats.passes
+                      << std::setw(10) << stats.waiting << "\n";
+        }
+
+        for (auto street_id: timeline_streets) {
+            std::cout << "\nQueue of street " << street_id << " (time: cars):\n";
+            for (auto &&[time, length]: queue_timeline(intervals[street_id])) {
+                std::cout << "  " << time << ": " << length << "\n";
+            }
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
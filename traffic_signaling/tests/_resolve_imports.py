@@ -17,4 +17,9 @@ except ModuleNotFoundError:
 try:
     from traffic_signaling.utils import *
 except ModuleNotFoundError:
-    from utils import *
\ No newline at end of file
+    from utils import *
+
+try:
+    from traffic_signaling.evaluation_client import *
+except ModuleNotFoundError:
+    from evaluation_client import *
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto adaptive = simulation::adaptive_simulation(city_plan);
+    auto adaptive_score = adaptive.score();
+
+    simulation::Simulation simulation{city_plan};
+    auto variants = simulation.adaptive_variants(6, "default", simulation::Schedule::DEFAULT_DIVISOR, 7, 3);
+    assert_equal(variants.size(), 6, "[variants] Wrong number of variants");
+    assert_equal(simulation.score(), variants.front().score, "[variants] The best variant is not set");
+
+    for (size_t i = 0; i < variants.size(); ++i) {
+        auto &&variant = variants[i];
+        if (i > 0) {
+            assert_equal(variant.score <= variants[i - 1].score, true, "[variants] Variants are not sorted");
+        }
+        // Variant 0 is the plain adaptive construction
+        if (variant.variant == 0) {
+            assert_equal(variant.score, adaptive_score, "[variants] Score mismatch of variant 0");
+            assert_equal(
+                variant.schedules == adaptive.non_trivial_schedules(), true, "[variants] Schedules mismatch of variant 0"
+            );
+        }
+        auto reference = simulation::default_simulation(city_plan);
+        reference.set_non_trivial_schedules(std::vector{variant.schedules});
+        assert_equal(reference.score(), variant.score, "[variants] Score mismatch of a fresh simulation");
+    }
+
+    // The variants don't depend on the number of threads
+    simulation::Simulation single_thread{city_plan};
+    auto single_thread_variants = single_thread.adaptive_variants(
+        6, "default", simulation::Schedule::DEFAULT_DIVISOR, 7, 1
+    );
+    for (size_t i = 0; i < variants.size(); ++i) {
+        assert_equal(single_thread_variants[i].variant, variants[i].variant, "[threads] Variant mismatch");
+        assert_equal(
+            single_thread_variants[i].schedules == variants[i].schedules, true, "[threads] Schedules mismatch"
+        );
+    }
+
+    std::cout << "Adaptive score " << adaptive_score << ", best variant " << variants.front().variant
+              << " with score " << variants.front().score << "\n";
+    std::cout << "Adaptive variants match the construction runs\n";
+}
@@ -0,0 +1,45 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestAdaptiveVariants(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_adaptive_variants(self, data):
+        plan = create_city_plan(data)
+        simulation = Simulation(plan)
+        variants = simulation.adaptive_variants(4, seed=7, threads=2, relative_order=True)
+        self.assertEqual(len(variants), 4)
+        self.assertEqual(sorted(variant.variant for variant in variants), [0, 1, 2, 3])
+        scores = [variant.score for variant in variants]
+        self.assertEqual(scores, sorted(scores, reverse=True))
+        self.assertEqual(simulation.score(), scores[0])
+
+        # Variant 0 is the plain adaptive construction
+        variant = next(variant for variant in variants if variant.variant == 0)
+        self.assertEqual(variant.score, ADAPTIVE_SCORE[data])
+
+        # The variants don't depend on the number of threads
+        single_thread_variants = Simulation(plan).adaptive_variants(4, seed=7, threads=1, relative_order=True)
+        self.assertEqual(
+            [(variant.variant, variant.schedules) for variant in single_thread_variants],
+            [(variant.variant, variant.schedules) for variant in variants]
+        )
+
+    def test_invalid_variants(self):
+        simulation = Simulation(create_city_plan('a'))
+        with self.assertRaises(ValueError):
+            simulation.adaptive_variants(0)
+        with self.assertRaises(ValueError):
+            simulation.adaptive_variants(2, times='invalid')
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,65 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto simulation = simulation::default_simulation(city_plan);
+    simulation.set_score_cache(std::make_shared<simulation::ScoreCache>());
+    auto score = simulation.score();
+
+    // The sample of all cars gives the exact score
+    simulation.set_car_sample(1.0);
+    assert_equal(simulation.car_sample().size(), city_plan.cars().size(), "[all] Not all cars sampled");
+    auto all = simulation.sampled_score();
+    assert_equal(all.estimate, score, "[all] Estimate differs from the score");
+    assert_equal(all.score, score, "[all] Score of the sampled cars differs from the score");
+    assert_equal(all.error == 0.0, true, "[all] Nonzero error");
+
+    // The sample only depends on the fraction and the seed
+    auto fraction = 0.1;
+    simulation.set_car_sample(fraction, 7);
+    auto sample = simulation.car_sample();
+    auto expected_cars = std::max(std::lround(fraction * static_cast<double>(city_plan.cars().size())), 1L);
+    assert_equal(sample.size(), static_cast<unsigned long>(expected_cars), "[sample] Wrong number of sampled cars");
+    auto other = simulation::default_simulation(city_plan);
+    other.set_car_sample(fraction, 7);
+    assert_equal(other.car_sample() == sample, true, "[sample] Sample differs for the same seed");
+
+    auto sampled = simulation.sampled_score();
+    assert_equal(sampled.cars, sample.size(), "[sample] Wrong number of simulated cars");
+    assert_equal(sampled.score <= score, true, "[sample] Sampled cars score more than all cars");
+    assert_equal(
+        other.sampled_score().estimate, sampled.estimate, "[sample] Estimate differs for the same sample"
+    );
+
+    // The sampled runs are not cached, and they don't change the full runs
+    simulation.score_cache()->clear();
+    assert_equal(simulation.score(), score, "[full] Score changed after a sampled run");
+    simulation.clear_car_sample();
+    assert_equal(simulation.car_sample().empty(), true, "[clear] Sample not cleared");
+
+    std::cout << "Score " << score << ", estimate from " << sampled.cars << " cars " << sampled.estimate
+              << " +- " << sampled.error << "\n";
+    std::cout << "Sampled scores match the simulation scores\n";
+}
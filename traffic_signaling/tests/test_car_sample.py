@@ -0,0 +1,50 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestCarSample(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_car_sample(self, data):
+        plan = create_city_plan(data)
+        simulation = default_simulation(plan)
+
+        # The sample of all cars gives the exact score
+        simulation.set_car_sample(1.0)
+        self.assertEqual(len(simulation.car_sample), len(plan.cars))
+        sampled = simulation.sampled_score()
+        self.assertEqual(sampled.estimate, DEFAULT_SCORE[data])
+        self.assertEqual(sampled.error, 0.0)
+
+        # The sample only depends on the fraction and the seed
+        simulation.set_car_sample(0.1, seed=3)
+        other = default_simulation(plan)
+        other.set_car_sample(0.1, seed=3)
+        self.assertEqual(simulation.car_sample, other.car_sample)
+        self.assertEqual(simulation.sampled_score().estimate, other.sampled_score().estimate)
+        self.assertEqual(simulation.score(), DEFAULT_SCORE[data])
+
+    def test_calibration(self):
+        calibration = calibrate_car_sample('b', fraction=0.2, seeds=2)
+        self.assertEqual(set(calibration), {'bias', 'rmse', 'error', 'speedup'})
+        self.assertLessEqual(abs(calibration['bias']), calibration['rmse'])
+
+    def test_invalid_sample(self):
+        simulation = default_simulation(create_city_plan('a'))
+        with self.assertRaises(RuntimeError):
+            simulation.sampled_score()
+        with self.assertRaises(ValueError):
+            simulation.set_car_sample(0.0)
+        with self.assertRaises(ValueError):
+            simulation.set_car_sample(1.5)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto parent = simulation::default_simulation(city_plan);
+    auto adaptive_schedules = simulation::adaptive_simulation(city_plan).non_trivial_schedules();
+
+    // The child takes the adaptive schedules of every second non-trivial intersection
+    std::vector<unsigned long> indices;
+    std::vector<std::vector<unsigned long>> orders;
+    std::vector<std::vector<unsigned long>> times;
+    for (unsigned long i = 0; i < adaptive_schedules.size(); i += 2) {
+        indices.push_back(i);
+        orders.push_back(adaptive_schedules[i].first);
+        times.push_back(adaptive_schedules[i].second);
+    }
+    auto child = simulation::default_simulation(city_plan);
+    child.update_schedules(indices, orders, times);
+    auto parent_score = parent.score();
+    auto child_score = child.score();
+
+    parent.clear_dirty_intersections();
+    auto hash = parent.schedules_hash();
+    auto comparison = parent.compare(indices, orders, times);
+    assert_equal(comparison.score, parent_score, "[compare] Parent score mismatch");
+    assert_equal(comparison.other_score, child_score, "[compare] Child score mismatch");
+    assert_equal(comparison.score_delta, static_cast<long>(child_score) - static_cast<long>(parent_score),
+                 "[compare] Score delta mismatch");
+    assert_equal(parent.schedules_hash(), hash, "[compare] Parent schedules were not restored");
+    assert_equal(parent.dirty_intersections().size(), 0, "[compare] Parent schedules were marked as changed");
+
+    long score_delta = 0;
+    for (unsigned long i = 0; i < comparison.cars.size(); ++i) {
+        auto &&car = comparison.cars[i];
+        assert_equal(i == 0 || comparison.cars[i - 1].car_id < car.car_id, true, "[cars] Cars are not ordered");
+        assert_equal(car.arrival_time != car.other_arrival_time, true, "[cars] Unchanged car was listed");
+        score_delta += car.score_delta;
+    }
+    assert_equal(score_delta, comparison.score_delta, "[cars] Car score deltas don't sum to the score delta");
+
+    // The second comparison reuses the parent run, and the street engine gives the same result
+    parent.set_engine("street");
+    auto street_comparison = parent.compare(indices, orders, times);
+    assert_equal(street_comparison.other_score, child_score, "[engine] Child score mismatch");
+    assert_equal(street_comparison.cars.size(), comparison.cars.size(), "[engine] Changed cars mismatch");
+    for (unsigned long i = 0; i < comparison.cars.size(); ++i) {
+        assert_equal(street_comparison.cars[i].car_id, comparison.cars[i].car_id, "[engine] Changed car mismatch");
+        assert_equal(street_comparison.cars[i].other_arrival_time == comparison.cars[i].other_arrival_time, true,
+                     "[engine] Arrival time mismatch");
+    }
+    assert_equal(parent.score(), parent_score, "[compare] Parent score changed after comparing");
+
+    // A child changing only the latest reachable intersection is resumed from a late snapshot of the parent,
+    // and a child changing the first intersection then needs an earlier one
+    std::vector<unsigned long> single_indices;
+    unsigned long latest_arrival = 0;
+    for (unsigned long i = 0; auto &&intersection: city_plan.non_trivial_intersections()) {
+        auto earliest_arrival = city_plan.earliest_arrival(intersection.id()).value_or(0);
+        if (single_indices.empty() || earliest_arrival > latest_arrival) {
+            single_indices = {i};
+            latest_arrival = earliest_arrival;
+        }
+        ++i;
+    }
+    if (!single_indices.empty()) {
+        single_indices.push_back(0);
+    }
+    for (auto index: single_indices) {
+        auto single_child = simulation::default_simulation(city_plan);
+        single_child.update_schedules({index}, {adaptive_schedules[index].first}, {adaptive_schedules[index].second});
+        auto single_comparison = parent.compare(
+            {index}, {adaptive_schedules[index].first}, {adaptive_schedules[index].second}
+        );
+        assert_equal(single_comparison.score, parent_score, "[single] Parent score mismatch");
+        assert_equal(single_comparison.other_score, single_child.score(), "[single] Child score mismatch");
+    }
+
+    // Comparing with no changes gives no changed cars
+    auto empty_comparison = parent.compare({}, {}, {});
+    assert_equal(empty_comparison.score_delta, 0, "[empty] Score delta of the same schedules");
+    assert_equal(empty_comparison.cars.size(), 0, "[empty] Changed cars of the same schedules");
+
+    std::cout << "Comparisons match the simulation scores\n";
+}
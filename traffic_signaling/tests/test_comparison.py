@@ -0,0 +1,57 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestComparison(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_compare(self, data):
+        plan = create_city_plan(data)
+        parent = default_simulation(plan)
+        adaptive_schedules = adaptive_simulation(plan).non_trivial_schedules()
+
+        # The child takes the adaptive schedules of every second non-trivial intersection
+        indices = list(range(0, len(adaptive_schedules), 2))
+        orders = [adaptive_schedules[i][0] for i in indices]
+        times = [adaptive_schedules[i][1] for i in indices]
+        child = default_simulation(plan)
+        child.update_schedules(indices, orders, times)
+        parent_score = parent.score()
+        child_score = child.score()
+
+        parent.clear_dirty_intersections()
+        schedules_hash = parent.schedules_hash
+        comparison = parent.compare(indices, orders, times)
+        self.assertEqual(comparison.score, parent_score)
+        self.assertEqual(comparison.other_score, child_score)
+        self.assertEqual(comparison.score_delta, child_score - parent_score)
+        self.assertEqual(parent.schedules_hash, schedules_hash)
+        self.assertEqual(parent.dirty_intersections, [])
+
+        car_ids = [car.car_id for car in comparison.cars]
+        self.assertEqual(car_ids, sorted(car_ids))
+        self.assertEqual(sum(car.score_delta for car in comparison.cars), comparison.score_delta)
+        for car in comparison.cars:
+            self.assertNotEqual(car.arrival_time, car.other_arrival_time)
+
+        # The street engine gives the same changed cars
+        parent.engine = 'street'
+        street_comparison = parent.compare(indices, orders, times)
+        self.assertEqual([car.car_id for car in street_comparison.cars], car_ids)
+        self.assertEqual(parent.score(), parent_score)
+
+    def test_invalid_index(self):
+        simulation = default_simulation(create_city_plan('a'))
+        with self.assertRaises(ValueError):
+            simulation.compare([len(simulation.non_trivial_schedules())], [[]], [[]])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,25 @@
+import os
+import socket
+import tempfile
+import unittest
+
+from _resolve_imports import *
+
+class TestEvaluationClient(unittest.TestCase):
+    def test_invalid_schedule(self):
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'daemon.sock')
+            with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as server:
+                server.bind(path)
+                server.listen()
+                with EvaluationClient(path) as client:
+                    connection, _ = server.accept()
+                    with connection:
+                        # A schedule whose order and times have different sizes is rejected before sending anything
+                        with self.assertRaises(ValueError):
+                            client.score(0, [[([0, 1], [1])]])
+                        client.close()
+                        self.assertEqual(connection.recv(1), b'')
+
+if __name__ == '__main__':
+    unittest.main()
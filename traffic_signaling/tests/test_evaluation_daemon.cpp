@@ -0,0 +1,138 @@
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "evaluation_daemon/daemon.hpp"
+
+using namespace std::string_literals; // for string operator""s
+using evaluation_daemon::Connection;
+using evaluation_daemon::Request;
+using evaluation_daemon::Status;
+using evaluation_daemon::Word;
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+void write_score_request(
+    Connection &connection, Word plan_id, bool relative_order,
+    const std::vector<simulation::EvaluationPool::Schedules> &batch
+) {
+    connection.write(static_cast<Word>(Request::SCORE));
+    connection.write(plan_id);
+    connection.write(relative_order);
+    connection.write(batch.size());
+    for (auto &&schedules: batch) {
+        connection.write(schedules.size());
+        for (auto &&[order, times]: schedules) {
+            connection.write(order.size());
+            for (auto street: order) {
+                connection.write(street);
+            }
+            for (auto time: times) {
+                connection.write(time);
+            }
+        }
+    }
+    connection.flush();
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    simulation::Simulation simulation{city_plan};
+
+    auto socket_path = std::filesystem::temp_directory_path() / ("traffic_signaling_test_" + data + ".sock");
+    evaluation_daemon::Daemon daemon{socket_path.string(), 2};
+    std::thread server{[&daemon] { daemon.serve(); }};
+    {
+        auto connection = Connection::connect(socket_path.string());
+
+        connection.write(static_cast<Word>(Request::LOAD));
+        connection.write_string(input_file);
+        connection.flush();
+        assert_equal(connection.read(), static_cast<Word>(Status::OK), "[load] Request failed");
+        auto plan_id = connection.read();
+
+        // Loading the same file again gives the same plan
+        connection.write(static_cast<Word>(Request::LOAD));
+        connection.write_string(input_file);
+        connection.flush();
+        assert_equal(connection.read(), static_cast<Word>(Status::OK), "[load again] Request failed");
+        assert_equal(connection.read(), plan_id, "[load again] Plan ID mismatch");
+
+        for (auto relative_order: {false, true}) {
+            std::vector<simulation::EvaluationPool::Schedules> batch;
+            std::vector<unsigned long> expected_scores;
+            for (auto &&schedule_option: {"default"s, "adaptive"s, "scaled"s}) {
+                simulation.create_schedules(schedule_option == "adaptive" ? "adaptive" : "default",
+                                            schedule_option == "scaled" ? "scaled" : "default");
+                expected_scores.push_back(simulation.score());
+                batch.push_back(simulation.non_trivial_schedules(relative_order));
+            }
+
+            write_score_request(connection, plan_id, relative_order, batch);
+            assert_equal(connection.read(), static_cast<Word>(Status::OK), "[score] Request failed");
+            assert_equal(connection.read(), batch.size(), "[score] Batch size mismatch");
+            for (auto expected: expected_scores) {
+                auto score = connection.read();
+                assert_equal(
+                    score, expected, "[score] Score mismatch: " + std::to_string(score) + " != "
+                    + std::to_string(expected)
+                );
+            }
+        }
+
+        // Failed requests are reported and the connection can still be used
+        write_score_request(connection, plan_id + 1, false, {simulation.non_trivial_schedules()});
+        assert_equal(connection.read(), static_cast<Word>(Status::ERROR), "[unknown plan] Request didn't fail");
+        std::cout << "Expected error: " << connection.read_string() << "\n";
+
+        write_score_request(connection, plan_id, false, {{}});
+        auto status = connection.read();
+        if (city_plan.non_trivial_intersections().empty()) {
+            assert_equal(status, static_cast<Word>(Status::OK), "[no schedules] Request failed");
+            assert_equal(connection.read(), 1, "[no schedules] Batch size mismatch");
+            connection.read();
+        }
+        else {
+            assert_equal(status, static_cast<Word>(Status::ERROR), "[too few schedules] Request didn't fail");
+            std::cout << "Expected error: " << connection.read_string() << "\n";
+        }
+
+        // A file that can't be loaded doesn't leave a plan behind
+        connection.write(static_cast<Word>(Request::LOAD));
+        connection.write_string(input_file + ".missing");
+        connection.flush();
+        assert_equal(connection.read(), static_cast<Word>(Status::ERROR), "[missing file] Request didn't fail");
+        std::cout << "Expected error: " << connection.read_string() << "\n";
+        write_score_request(connection, plan_id + 1, false, {simulation.non_trivial_schedules()});
+        assert_equal(
+            connection.read(), static_cast<Word>(Status::ERROR), "[missing file plan] Request didn't fail"
+        );
+        std::cout << "Expected error: " << connection.read_string() << "\n";
+
+        connection.write(static_cast<Word>(Request::LOAD));
+        connection.write_string(input_file);
+        connection.flush();
+        assert_equal(connection.read(), static_cast<Word>(Status::OK), "[load after error] Request failed");
+        assert_equal(connection.read(), plan_id, "[load after error] Plan ID mismatch");
+    }
+    daemon.stop();
+    server.join();
+    std::cout << "Daemon scores match the simulation scores\n";
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/evaluation_pool.hpp"
+
+using namespace std::string_literals; // for string operator""s
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    simulation::Simulation simulation{city_plan};
+    // Pinning is ignored on platforms that don't support it, so the results are the same everywhere
+    simulation::EvaluationPool pool{city_plan, 4, nullptr, true};
+
+    // Submit all schedules before waiting for any of them, so that the workers score them in parallel
+    std::vector<std::string> options;
+    std::vector<unsigned long> expected_scores;
+    std::vector<simulation::ScoreFuture> futures;
+    for (auto &&schedule_option: {"default"s, "adaptive"s, "scaled"s}) {
+        if (schedule_option == "default") {
+            simulation.default_schedules();
+        }
+        else if (schedule_option == "adaptive") {
+            simulation.adaptive_schedules();
+        }
+        else if (schedule_option == "scaled") {
+            simulation.scaled_schedules();
+        }
+
+        auto expected = simulation.score();
+        for (auto relative_order: {false, true}) {
+            for (int i = 0; i < 4; ++i) {
+                options.push_back(schedule_option);
+                expected_scores.push_back(expected);
+                futures.push_back(pool.submit(simulation.non_trivial_schedules(relative_order), relative_order));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto score = futures[i].result();
+        assert_equal(
+            futures[i].done(), true, "[" + options[i] + "] Future is not done after returning the result"
+        );
+        assert_equal(
+            score, expected_scores[i],
+            "[" + options[i] + "] Score mismatch: " + std::to_string(score)
+            + " != " + std::to_string(expected_scores[i])
+        );
+    }
+
+    // Invalid schedules are rejected when they are submitted, instead of being read out of bounds by a worker
+    auto schedules = simulation.non_trivial_schedules(true);
+    std::vector<std::pair<std::string, simulation::EvaluationPool::Schedules>> invalid;
+    if (!schedules.empty()) {
+        invalid.emplace_back("too few schedules", schedules).second.pop_back();
+        invalid.emplace_back("too many schedules", schedules).second.push_back(schedules.back());
+        invalid.emplace_back("times size", schedules).second[0].second.push_back(1);
+        auto &&[order, times] = invalid.emplace_back("street index", schedules).second[0];
+        order.push_back(city_plan.streets().size());
+        times.push_back(1);
+    }
+    for (auto &&[name, invalid_schedules]: invalid) {
+        bool failed = false;
+        try {
+            pool.submit(std::move(invalid_schedules), true);
+        }
+        catch (const std::invalid_argument &) {
+            failed = true;
+        }
+        assert_equal(failed, true, "[" + name + "] Submission didn't fail");
+    }
+
+    unsigned long scored = 0;
+    for (auto count: pool.scored()) {
+        scored += count;
+    }
+    assert_equal(scored, futures.size(), "Number of scored jobs doesn't match the number of submitted jobs");
+    std::cout << "Pool scores match the simulation scores\n";
+}
@@ -0,0 +1,78 @@
+import sys
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestEvaluationPool(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_submit(self, data):
+        plan = create_city_plan(data)
+        simulation = Simulation(plan)
+        pool = EvaluationPool(plan, threads=4)
+        self.assertEqual(pool.threads, 4)
+
+        # Submit all schedules before waiting for any of them, so that the workers score them in parallel
+        expected_scores = []
+        futures = []
+        for schedule_option in ['default', 'adaptive', 'scaled']:
+            getattr(simulation, f'{schedule_option}_schedules')()
+            expected = simulation.score()
+            for relative_order in [False, True]:
+                schedules = simulation.non_trivial_schedules(relative_order=relative_order)
+                expected_scores.append(expected)
+                futures.append(pool.submit(schedules, relative_order=relative_order))
+
+        for future, expected in zip(futures, expected_scores):
+            self.assertEqual(future.result(), expected)
+            self.assertTrue(future.done())
+        self.assertEqual(sum(pool.scored), len(futures))
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_pinned(self, data):
+        plan = create_city_plan(data)
+        simulation = default_simulation(plan)
+        pool = EvaluationPool(plan, threads=2, pin_threads=True)
+        # Only pools whose workers all pinned themselves report it
+        self.assertEqual(pool.pinned, sys.platform.startswith('linux'))
+        self.assertFalse(EvaluationPool(plan, threads=1).pinned)
+        futures = [pool.submit(simulation.non_trivial_schedules()) for _ in range(4)]
+        for future in futures:
+            self.assertEqual(future.result(), simulation.score())
+        self.assertEqual(len(pool.scored), 2)
+        self.assertEqual(sum(pool.scored), 4)
+
+    def test_invalid_schedules(self):
+        plan = create_city_plan('d')
+        schedules = default_simulation(plan).non_trivial_schedules(relative_order=True)
+        pool = EvaluationPool(plan, threads=1)
+        # Invalid schedules are rejected when they are submitted, instead of being read out of bounds by a worker
+        (order, times), *rest = schedules
+        invalid = [
+            schedules[:-1],
+            schedules + schedules[-1:],
+            [(order, times + [1])] + rest,
+            [(order + [len(plan.streets)], times + [1])] + rest
+        ]
+        for invalid_schedules in invalid:
+            with self.assertRaises(ValueError):
+                pool.submit(invalid_schedules, relative_order=True)
+        self.assertEqual(sum(pool.scored), 0)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,58 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+
+    // The remaining durations of the first streets are the durations of the paths
+    for (auto &&car: city_plan.cars()) {
+        assert_equal(
+            city_plan.path_remaining_durations()[city_plan.path_offsets()[car.id()]], car.path_duration(),
+            "[durations] Remaining duration of the first street differs from the path duration"
+        );
+    }
+
+    for (auto simulation: {simulation::default_simulation(city_plan), simulation::adaptive_simulation(city_plan)}) {
+        auto score = simulation.score();
+
+        // From the duration of the simulation on, the estimate is the exact score
+        assert_equal(simulation.score(city_plan.duration()), score, "[exact] Estimate at the duration differs");
+        assert_equal(simulation.score(city_plan.duration() * 2), score, "[exact] Estimate after the duration differs");
+
+        // Close to the end of the simulation, only a few cars are on their way
+        auto estimate = simulation.score(city_plan.duration() * 9 / 10);
+        auto error = std::abs(static_cast<double>(estimate) - static_cast<double>(score)) / static_cast<double>(score);
+        assert_equal(error < 0.05, true, "[estimate] Estimate at 90 % of the duration is off by more than 5 %");
+        std::cout << "Score " << score << ", estimate at 90 % of the duration " << estimate << "\n";
+
+        // The estimate doesn't change the full run
+        assert_equal(simulation.score(), score, "[exact] Score changed after an estimate");
+
+        // The exact score is taken from the cache
+        simulation.set_score_cache(std::make_shared<simulation::ScoreCache>());
+        simulation.score();
+        assert_equal(simulation.score(1), score, "[cache] Estimate ignores the cached score");
+    }
+    std::cout << "Horizon estimates match the full scores\n";
+}
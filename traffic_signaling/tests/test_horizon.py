@@ -0,0 +1,37 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestHorizon(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_horizon(self, data):
+        plan = create_city_plan(data)
+        simulation = default_simulation(plan)
+
+        # From the duration of the simulation on, the estimate is the exact score
+        self.assertEqual(simulation.score(plan.duration), DEFAULT_SCORE[data])
+        self.assertEqual(simulation.score(horizon=2 * plan.duration), DEFAULT_SCORE[data])
+
+        # Close to the end of the simulation, only a few cars are on their way
+        estimate = simulation.score(horizon=plan.duration * 9 // 10)
+        self.assertLess(abs(estimate - DEFAULT_SCORE[data]), 0.05 * DEFAULT_SCORE[data])
+        self.assertEqual(simulation.score(), DEFAULT_SCORE[data])
+
+    def test_remaining_durations(self):
+        plan = create_city_plan('a')
+        self.assertEqual(len(plan.path_remaining_durations), len(plan.path_street_ids))
+        for car in plan.cars:
+            offset = plan.path_offsets[car.id]
+            self.assertEqual(plan.path_remaining_durations[offset], car.path_duration())
+
+if __name__ == '__main__':
+    unittest.main()
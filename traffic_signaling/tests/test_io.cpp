@@ -1,3 +1,4 @@
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -57,9 +58,94 @@ void test_io(const std::vector<std::string> &args, bool same_instance = false) {
     }
 }
 
+void test_street_names(const std::vector<std::string> &args) {
+    auto &&input_file = args[0];
+
+    city_plan::CityPlan city_plan{input_file};
+    std::ifstream file{input_file};
+    unsigned long duration, intersections, streets, cars, bonus;
+    file >> duration >> intersections >> streets >> cars >> bonus;
+    assert_equal(streets, city_plan.streets().size(), "[test_street_names] Wrong number of streets");
+
+    unsigned long start_id, end_id, length;
+    std::string name;
+    for (unsigned long id = 0; id < streets; ++id) {
+        file >> start_id >> end_id >> name >> length;
+        assert_equal(city_plan.street_name(id) == name, true, "[test_street_names] Wrong name of street " + name);
+        assert_equal(city_plan.street_id(name), id, "[test_street_names] Wrong ID of street " + name);
+    }
+}
+
+void test_flat_arrays(const std::vector<std::string> &args) {
+    auto &&input_file = args[0];
+
+    city_plan::CityPlan city_plan{input_file};
+    for (auto &&street: city_plan.streets()) {
+        auto id = street.id();
+        assert_equal(city_plan.street_starts()[id], street.start().id(), "[test_flat_arrays] Wrong street start");
+        assert_equal(city_plan.street_ends()[id], street.end().id(), "[test_flat_arrays] Wrong street end");
+        assert_equal(city_plan.street_lengths()[id], street.length(), "[test_flat_arrays] Wrong street length");
+        assert_equal(city_plan.street_total_cars()[id], street.total_cars(), "[test_flat_arrays] Wrong total cars");
+    }
+
+    auto &&path_offsets = city_plan.path_offsets();
+    assert_equal(path_offsets.size(), city_plan.cars().size() + 1, "[test_flat_arrays] Wrong number of paths");
+    for (auto &&car: city_plan.cars()) {
+        auto &&path = car.path();
+        assert_equal(path_offsets[car.id() + 1] - path_offsets[car.id()], path.size(), "[test_flat_arrays] Wrong path length");
+        for (unsigned long i = 0; i < path.size(); ++i) {
+            assert_equal(
+                city_plan.path_street_ids()[path_offsets[car.id()] + i], path[i].id(),
+                "[test_flat_arrays] Wrong street in path"
+            );
+        }
+    }
+
+    auto &&used_street_offsets = city_plan.used_street_offsets();
+    assert_equal(
+        used_street_offsets.size(), city_plan.intersections().size() + 1,
+        "[test_flat_arrays] Wrong number of intersections"
+    );
+    for (auto &&intersection: city_plan.intersections()) {
+        auto &&used_streets = intersection.used_streets();
+        auto offset = used_street_offsets[intersection.id()];
+        assert_equal(
+            used_street_offsets[intersection.id() + 1] - offset, used_streets.size(),
+            "[test_flat_arrays] Wrong number of used streets"
+        );
+        for (unsigned long i = 0; i < used_streets.size(); ++i) {
+            assert_equal(
+                city_plan.used_street_ids()[offset + i], used_streets[i].get().id(),
+                "[test_flat_arrays] Wrong used street"
+            );
+        }
+    }
+}
+
+void test_parallel_parsing(const std::vector<std::string> &args) {
+    auto &&input_file = args[0];
+
+    city_plan::CityPlan sequential{input_file, 1};
+    city_plan::CityPlan parallel{input_file, 8};
+    auto assert_same = [](auto &&a, auto &&b, std::string_view msg) {
+        assert_equal(a == b, true, msg);
+    };
+    assert_same(sequential.street_total_cars(), parallel.street_total_cars(), "[test_parallel_parsing] Wrong total cars");
+    assert_same(sequential.path_offsets(), parallel.path_offsets(), "[test_parallel_parsing] Wrong path offsets");
+    assert_same(sequential.path_street_ids(), parallel.path_street_ids(), "[test_parallel_parsing] Wrong paths");
+    assert_same(
+        sequential.used_street_offsets(), parallel.used_street_offsets(),
+        "[test_parallel_parsing] Wrong used street offsets"
+    );
+    assert_same(sequential.used_street_ids(), parallel.used_street_ids(), "[test_parallel_parsing] Wrong used streets");
+}
+
 int main(int argc, char *argv[]) {
     std::vector<std::string> args{argv + 1, argv + argc};
 
+    test_street_names(args);
+    test_flat_arrays(args);
+    test_parallel_parsing(args);
     test_io(args);
     test_io(args, true);
 }
\ No newline at end of file
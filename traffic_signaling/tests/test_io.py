@@ -62,5 +62,70 @@ class TestIO(unittest.TestCase):
             simulation.load_schedules(output)
             self.assertEqual(score, simulation.score())
 
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_street_names(self, data):
+        plan = create_city_plan(data)
+        with open(get_data_filename(data)) as f:
+            f.readline()
+            for street in plan.streets:
+                _, _, name, _ = f.readline().split()
+                self.assertEqual(plan.street_name(street.id), name)
+                self.assertEqual(plan.street_id(name), street.id)
+
+        with self.assertRaises(IndexError):
+            plan.street_id('not a street')
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_flat_arrays(self, data):
+        plan = create_city_plan(data)
+        streets = plan.streets
+        self.assertEqual(list(plan.street_starts), [street.start.id for street in streets])
+        self.assertEqual(list(plan.street_ends), [street.end.id for street in streets])
+        self.assertEqual(list(plan.street_lengths), [street.length for street in streets])
+        self.assertEqual(list(plan.street_total_cars), [street.total_cars for street in streets])
+
+        path_offsets, path_street_ids = plan.path_offsets, plan.path_street_ids
+        for car in plan.cars:
+            path = path_street_ids[path_offsets[car.id]:path_offsets[car.id + 1]]
+            self.assertEqual(list(path), [street.id for street in car.path])
+
+        used_street_offsets, used_street_ids = plan.used_street_offsets, plan.used_street_ids
+        for intersection in plan.intersections:
+            used_streets = used_street_ids[used_street_offsets[intersection.id]:used_street_offsets[intersection.id + 1]]
+            self.assertEqual(list(used_streets), [street.id for street in intersection.used_streets])
+
+        # The arrays are views of the city plan, so they must not be writable
+        self.assertFalse(path_street_ids.flags.writeable)
+        with self.assertRaises(ValueError):
+            path_street_ids[0] = 0
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_parallel_parsing(self, data):
+        sequential = CityPlan(get_data_filename(data), threads=1)
+        parallel = CityPlan(get_data_filename(data), threads=8)
+        for array in ['street_total_cars', 'path_offsets', 'path_street_ids', 'used_street_offsets', 'used_street_ids']:
+            self.assertEqual(list(getattr(sequential, array)), list(getattr(parallel, array)))
+
 if __name__ == '__main__':
     unittest.main()
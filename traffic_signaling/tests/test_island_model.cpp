@@ -0,0 +1,84 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/island_model.hpp"
+#include "simulation/migration_queue.hpp"
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    // The queue keeps the order of the values and rejects values when it's full
+    simulation::MigrationQueue<unsigned long> queue{2};
+    assert_equal(queue.push(1), true, "[queue] Push to an empty queue failed");
+    assert_equal(queue.push(2), true, "[queue] Push to a queue with room failed");
+    assert_equal(queue.push(3), false, "[queue] Push to a full queue succeeded");
+    assert_equal(*queue.pop(), 1, "[queue] Wrong first value");
+    assert_equal(*queue.pop(), 2, "[queue] Wrong second value");
+    assert_equal(queue.pop().has_value(), false, "[queue] Pop from an empty queue succeeded");
+
+    city_plan::CityPlan city_plan{input_file};
+    auto default_simulation = simulation::default_simulation(city_plan);
+    auto adaptive_simulation = simulation::adaptive_simulation(city_plan);
+    std::vector initial{
+        default_simulation.non_trivial_schedules(true), adaptive_simulation.non_trivial_schedules(true)
+    };
+    auto initial_best = std::max(default_simulation.score(), adaptive_simulation.score());
+
+    simulation::IslandParameters parameters;
+    parameters.islands = 3;
+    parameters.population = 6;
+    parameters.generations = 4;
+    parameters.migration_interval = 2;
+    parameters.migrants = 1;
+    parameters.mutation_indpb = 0.05;
+    auto result = simulation::island_genetic_algorithm(
+        city_plan, initial, parameters, std::make_shared<simulation::ScoreCache>()
+    );
+
+    auto reference = simulation::default_simulation(city_plan);
+    reference.set_non_trivial_schedules(std::vector{result.schedules}, true);
+    assert_equal(reference.score(), result.score, "[islands] Score mismatch of a fresh simulation");
+    assert_equal(result.score >= initial_best, true, "[islands] The result is worse than the initial individuals");
+
+    assert_equal(
+        result.history.size(), parameters.islands * (parameters.generations + 1), "[islands] Wrong history size"
+    );
+    unsigned long best_history_score = 0;
+    for (size_t i = 0; i < result.history.size(); ++i) {
+        auto &&generation = result.history[i];
+        assert_equal(generation.generation, i / parameters.islands, "[islands] History is not sorted");
+        assert_equal(generation.island, i % parameters.islands, "[islands] History is not sorted");
+        assert_equal(generation.max_score >= generation.average_score, true, "[islands] Average above the maximum");
+        if (generation.generation == 0) {
+            assert_equal(generation.evaluations, parameters.population, "[islands] Initial population not evaluated");
+        }
+        best_history_score = std::max(best_history_score, generation.max_score);
+    }
+    assert_equal(best_history_score, result.score, "[islands] The result is not the best of the history");
+
+    // The islands stop as soon as the target is reached
+    parameters.target = initial_best;
+    auto stopped = simulation::island_genetic_algorithm(city_plan, initial, parameters);
+    assert_equal(stopped.history.size(), parameters.islands, "[target] The islands did not stop");
+
+    std::cout << "Initial score " << initial_best << ", island model score " << result.score
+              << " with " << result.migrations << " migrations\n";
+    std::cout << "Island model matches the simulation scores\n";
+}
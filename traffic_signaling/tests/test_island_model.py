@@ -0,0 +1,62 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestIslandModel(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_island_model(self, data):
+        plan = create_city_plan(data)
+        initial = [
+            default_simulation(plan).non_trivial_schedules(relative_order=True),
+            adaptive_simulation(plan).non_trivial_schedules(relative_order=True)
+        ]
+        parameters = IslandParameters()
+        parameters.islands = 2
+        parameters.population = 4
+        parameters.generations = 3
+        parameters.migration_interval = 1
+        parameters.migrants = 1
+        result = island_genetic_algorithm(plan, initial, parameters, ScoreCache())
+
+        # The best individual is at least as good as the initial individuals
+        self.assertGreaterEqual(result.score, ADAPTIVE_SCORE[data])
+        simulation = default_simulation(plan)
+        simulation.set_non_trivial_schedules(result.schedules, relative_order=True)
+        self.assertEqual(simulation.score(), result.score)
+
+        self.assertEqual(len(result.history), parameters.islands * (parameters.generations + 1))
+        self.assertEqual(max(generation.max_score for generation in result.history), result.score)
+        self.assertEqual([generation.evaluations for generation in result.history[:2]], [4, 4])
+
+    def test_target(self):
+        plan = create_city_plan('a')
+        parameters = IslandParameters()
+        parameters.islands = 2
+        parameters.population = 4
+        parameters.target = DEFAULT_SCORE['a']
+        result = island_genetic_algorithm(plan, [default_simulation(plan).non_trivial_schedules(True)], parameters)
+        self.assertEqual(len(result.history), parameters.islands)
+
+    def test_invalid_parameters(self):
+        plan = create_city_plan('a')
+        with self.assertRaises(ValueError):
+            island_genetic_algorithm(plan, [])
+        parameters = IslandParameters()
+        parameters.islands = 0
+        with self.assertRaises(ValueError):
+            island_genetic_algorithm(plan, [default_simulation(plan).non_trivial_schedules(True)], parameters)
+        # The initial individuals are validated before any island starts
+        with self.assertRaises(ValueError):
+            island_genetic_algorithm(plan, [default_simulation(plan).non_trivial_schedules(True)[1:]])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto simulation = simulation::adaptive_simulation(city_plan);
+    simulation.set_score_cache(std::make_shared<simulation::ScoreCache>());
+    auto score = simulation.score();
+
+    // The statistics count every car that reached a traffic light
+    unsigned long cars = 0;
+    auto original_stats = simulation.queue_stats();
+    for (auto &&stats: original_stats) {
+        cars += stats.cars;
+        assert_equal(stats.cars >= stats.max_queue, true, "[stats] Queue longer than the number of cars");
+        assert_equal(stats.cars >= stats.waiting_cars, true, "[stats] More waiting cars than cars");
+        assert_equal(
+            stats.waiting_time >= stats.waiting_cars, true, "[stats] Waiting cars without their waiting time"
+        );
+    }
+    unsigned long passes = 0;
+    for (auto &&car: city_plan.cars()) {
+        passes += car.street_ids().size() - 1;
+    }
+    assert_equal(cars <= passes, true, "[stats] More cars than traffic lights on their paths");
+
+    // Rebalancing keeps the order and the cycle length of every schedule,
+    // and only the streets reached by a car get the green light unless no car reached the intersection
+    auto original = simulation.non_trivial_schedules();
+    simulation.rebalance_times();
+    auto rebalanced = simulation.non_trivial_schedules();
+    for (size_t i = 0; i < original.size(); ++i) {
+        auto &&[order, times] = rebalanced[i];
+        assert_equal(order == original[i].first, true, "[keep] Order changed");
+        auto reached = std::ranges::any_of(order, [&](auto street_id) { return original_stats[street_id].cars > 0; });
+        unsigned long cycle = 0;
+        unsigned long original_cycle = 0;
+        for (size_t j = 0; j < times.size(); ++j) {
+            if (reached) {
+                assert_equal(times[j] > 0, original_stats[order[j]].cars > 0, "[keep] Green light mismatch");
+            }
+            cycle += times[j];
+            original_cycle += original[i].second[j];
+        }
+        assert_equal(cycle, original_cycle, "[keep] Cycle length changed");
+    }
+    auto rebalanced_score = simulation.score();
+
+    // A cache hit doesn't run the simulation, so the statistics are collected again for the current schedules
+    simulation.set_non_trivial_schedules(std::move(original));
+    assert_equal(simulation.score(), score, "[cache] Score mismatch of the original schedules");
+    auto stats = simulation.queue_stats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        assert_equal(stats[i].cars, original_stats[i].cars, "[cache] Number of cars mismatch");
+        assert_equal(stats[i].waiting_cars, original_stats[i].waiting_cars, "[cache] Waiting cars mismatch");
+        assert_equal(stats[i].waiting_time, original_stats[i].waiting_time, "[cache] Waiting time mismatch");
+        assert_equal(stats[i].max_queue, original_stats[i].max_queue, "[cache] Longest queue mismatch");
+    }
+    simulation.set_non_trivial_schedules(std::move(rebalanced));
+
+    // The rebalanced schedules score the same in a fresh simulation
+    auto reference = simulation::default_simulation(city_plan);
+    reference.set_non_trivial_schedules(simulation.non_trivial_schedules());
+    assert_equal(reference.score(), rebalanced_score, "[score] Score mismatch of the rebalanced schedules");
+
+    // A target cycle length is followed unless the schedule has more streets with the green light
+    auto rebalanced_stats = simulation.queue_stats();
+    simulation.rebalance_times(7);
+    for (auto &&[order, times]: simulation.non_trivial_schedules()) {
+        unsigned long cycle = 0;
+        unsigned long used_streets = 0;
+        for (size_t j = 0; j < times.size(); ++j) {
+            cycle += times[j];
+            used_streets += rebalanced_stats[order[j]].cars > 0;
+        }
+        auto expected = std::max(7UL, used_streets > 0 ? used_streets : order.size());
+        assert_equal(cycle, expected, "[cycle] Cycle length mismatch");
+    }
+
+    std::cout << "Adaptive score " << score << ", rebalanced score " << rebalanced_score
+              << ", rebalanced with cycle 7 " << simulation.score() << "\n";
+    std::cout << "Rebalanced schedules keep their cycles\n";
+}
@@ -0,0 +1,80 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestRebalance(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_rebalance_times(self, data):
+        plan = create_city_plan(data)
+        simulation = adaptive_simulation(plan)
+        simulation.score()
+
+        stats = simulation.queue_stats()
+        for street_stats in stats:
+            self.assertGreaterEqual(street_stats.cars, street_stats.max_queue)
+            self.assertGreaterEqual(street_stats.cars, street_stats.waiting_cars)
+
+        # Rebalancing keeps the order and the cycle length of every schedule,
+        # and only the streets reached by a car get the green light unless no car reached the intersection
+        original = simulation.non_trivial_schedules()
+        simulation.rebalance_times()
+        for (order, times), (original_order, original_times) in zip(simulation.non_trivial_schedules(), original):
+            self.assertEqual(order, original_order)
+            self.assertEqual(sum(times), sum(original_times))
+            reached = [stats[street_id].cars > 0 for street_id in order]
+            if any(reached):
+                self.assertEqual([time > 0 for time in times], reached)
+
+        # A target cycle length is followed unless the schedule has more streets with the green light
+        stats = simulation.queue_stats()
+        simulation.rebalance_times(7)
+        rebalanced_score = simulation.score()
+        for order, times in simulation.non_trivial_schedules():
+            used_streets = sum(stats[street_id].cars > 0 for street_id in order)
+            self.assertEqual(sum(times), max(7, used_streets or len(order)))
+
+        reference = default_simulation(plan)
+        reference.set_non_trivial_schedules(simulation.non_trivial_schedules())
+        self.assertEqual(reference.score(), rebalanced_score)
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_queue_stats_after_cache_hit(self, data):
+        plan = create_city_plan(data)
+        simulation = adaptive_simulation(plan)
+        simulation.set_score_cache(ScoreCache())
+        score = simulation.score()
+        stats = [(s.cars, s.waiting_cars, s.waiting_time, s.max_queue) for s in simulation.queue_stats()]
+
+        # A cache hit doesn't run the simulation, so the statistics are collected again for the current schedules
+        original = simulation.non_trivial_schedules()
+        simulation.rebalance_times(7)
+        simulation.score()
+        simulation.set_non_trivial_schedules(original)
+        self.assertEqual(simulation.score(), score)
+        self.assertEqual(
+            [(s.cars, s.waiting_cars, s.waiting_time, s.max_queue) for s in simulation.queue_stats()], stats
+        )
+
+    def test_invalid_cycle(self):
+        simulation = default_simulation(create_city_plan('a'))
+        with self.assertRaises(ValueError):
+            simulation.rebalance_times(0)
+
+if __name__ == '__main__':
+    unittest.main()
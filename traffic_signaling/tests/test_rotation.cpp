@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+/** Number of intersections whose rotations are optimized, spread evenly over the non-trivial intersections. */
+constexpr unsigned long SAMPLED_INTERSECTIONS = 16;
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    std::cout
+        << "------------------------------- DATA "
+        << std::filesystem::path{input_file}.stem().string()
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    simulation::Simulation simulation{city_plan};
+    simulation.adaptive_schedules();
+    // The replica scores every rotation with a full run
+    simulation::Simulation replica{city_plan};
+    replica.adaptive_schedules();
+    auto schedules = simulation.non_trivial_schedules();
+
+    std::vector<unsigned long> intersection_ids;
+    for (auto &&intersection: city_plan.non_trivial_intersections()) {
+        intersection_ids.push_back(intersection.id());
+    }
+    auto step = std::max(intersection_ids.size() / SAMPLED_INTERSECTIONS, 1UL);
+
+    std::printf("%12s %9s %13s %12s %9s\n", "intersection", "rotations", "full runs (s)", "rotation (s)", "speedup");
+    double total_full = 0;
+    double total_rotation = 0;
+    for (unsigned long index = 0; index < intersection_ids.size(); index += step) {
+        auto intersection_id = intersection_ids[index];
+        auto rotations = schedules[index].first.size();
+
+        auto start = std::chrono::steady_clock::now();
+        std::pair<unsigned long, unsigned long> expected{0, 0};
+        for (unsigned long rotation = 0; rotation < rotations; ++rotation) {
+            auto rotated_schedules = schedules;
+            auto &&[order, times] = rotated_schedules[index];
+            std::ranges::rotate(order, order.begin() + static_cast<std::ptrdiff_t>(rotation));
+            std::ranges::rotate(times, times.begin() + static_cast<std::ptrdiff_t>(rotation));
+            replica.set_non_trivial_schedules(std::move(rotated_schedules));
+            auto score = replica.score();
+            if (rotation == 0 || score > expected.second) {
+                expected = {rotation, score};
+            }
+        }
+        auto full = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+
+        start = std::chrono::steady_clock::now();
+        auto best = simulation.optimize_rotation(intersection_id);
+        auto rotation = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+        if (best != expected) {
+            std::cout << "Rotation mismatch at intersection " << intersection_id << "\n";
+            throw std::runtime_error{"Rotation mismatch"};
+        }
+
+        // The best rotation is kept for the following intersections
+        auto &&[order, times] = schedules[index];
+        std::ranges::rotate(order, order.begin() + static_cast<std::ptrdiff_t>(best.first));
+        std::ranges::rotate(times, times.begin() + static_cast<std::ptrdiff_t>(best.first));
+        auto copy = schedules;
+        replica.set_non_trivial_schedules(std::move(copy));
+
+        total_full += full;
+        total_rotation += rotation;
+        std::printf("%12lu %9lu %13.3f %12.3f %8.2fx\n", intersection_id, rotations, full, rotation, full / rotation);
+    }
+    std::printf("%12s %9s %13.3f %12.3f %8.2fx\n", "total", "", total_full, total_rotation, total_full / total_rotation);
+    std::cout << "Rotation benchmark finished\n";
+}
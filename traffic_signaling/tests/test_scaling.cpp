@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "simulation/evaluation_pool.hpp"
+
+/** Number of jobs scored by each worker in one measurement. */
+constexpr unsigned long JOBS_PER_THREAD = 8;
+
+/**
+ * Score `JOBS_PER_THREAD` jobs per worker with the pool and return the elapsed time in seconds.
+ */
+double measure(simulation::EvaluationPool &pool, const simulation::EvaluationPool::Schedules &schedules) {
+    std::vector<simulation::ScoreFuture> futures;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < JOBS_PER_THREAD * pool.threads(); ++i) {
+        auto copy = schedules;
+        futures.push_back(pool.submit(std::move(copy)));
+    }
+    for (auto &&future: futures) {
+        future.result();
+    }
+    return std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+    // The maximum number of threads can be given after the output file, e.g. to match a machine's cores
+    auto max_threads = args.size() > 2 ? std::stoul(args[2]) : simulation::EvaluationPool::default_threads();
+
+    std::cout
+        << "------------------------------- DATA "
+        << std::filesystem::path{input_file}.stem().string()
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto simulation = simulation::default_simulation(city_plan);
+    simulation.adaptive_schedules();
+    auto schedules = simulation.non_trivial_schedules();
+
+    std::vector<unsigned long> thread_counts;
+    for (unsigned long threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::printf("%8s %12s %12s %11s %9s\n", "threads", "scores/s", "per thread", "efficiency", "balance");
+    double single_thread_throughput = 0;
+    for (auto threads: thread_counts) {
+        simulation::EvaluationPool pool{city_plan, threads, nullptr, true};
+        // The first run of every replica allocates its run state, so it's not measured
+        measure(pool, schedules);
+        auto before = pool.scored();
+        auto elapsed = measure(pool, schedules);
+        auto after = pool.scored();
+
+        // Ratio of the fewest and the most jobs scored by a worker, 1 if the jobs are spread evenly
+        unsigned long fewest = after[0] - before[0];
+        unsigned long most = fewest;
+        for (unsigned long i = 0; i < threads; ++i) {
+            fewest = std::min(fewest, after[i] - before[i]);
+            most = std::max(most, after[i] - before[i]);
+        }
+
+        auto throughput = static_cast<double>(JOBS_PER_THREAD * threads) / elapsed;
+        if (threads == 1) {
+            single_thread_throughput = throughput;
+        }
+        auto per_thread = throughput / static_cast<double>(threads);
+        std::printf(
+            "%8lu %12.2f %12.2f %10.1f%% %9.2f\n", threads, throughput, per_thread,
+            100 * per_thread / single_thread_throughput, static_cast<double>(fewest) / static_cast<double>(most)
+        );
+    }
+    std::cout << "Scaling benchmark finished\n";
+}
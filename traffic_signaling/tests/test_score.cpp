@@ -27,6 +27,25 @@ static const std::unordered_map<std::string_view, unsigned long> ADAPTIVE_SCORE{
     {"f", 824'879}
 };
 
+// Scores of adaptive order with scaled times using the divisors below.
+static const std::unordered_map<std::string_view, unsigned long> ADAPTIVE_SCALED_SCORE{
+    {"a", 2'002},
+    {"b", 4'568'650},
+    {"c", 1'306'052},
+    {"d", 2'481'644},
+    {"e", 732'774},
+    {"f", 1'382'455}
+};
+
+static const std::unordered_map<std::string_view, unsigned long> ADAPTIVE_DIVISOR{
+    {"a", 1},
+    {"b", 9},
+    {"c", 17},
+    {"d", 5},
+    {"e", 2},
+    {"f", 39}
+};
+
 // Theoretical maximum score if none of the cars ever has to wait at a traffic light.
 static const std::unordered_map<std::string_view, unsigned long> UPPER_BOUND{
     {"a", 2'002},
@@ -56,11 +75,15 @@ int main(int argc, char *argv[]) {
 
     city_plan::CityPlan city_plan{input_file};
     simulation::Simulation simulation{city_plan};
-    auto &&schedule_option = {"default"s, "adaptive"s, "random"s, "scaled"s};
+    // Simulation with the street engine must give exactly the same scores
+    simulation::Simulation street_simulation{city_plan};
+    street_simulation.set_engine("street");
+    auto &&schedule_option = {"default"s, "adaptive"s, "adaptive_scaled"s, "random"s, "scaled"s};
     for (auto &&option: schedule_option) {
         unsigned long expected{};
         if (option == "default") {
             simulation.default_schedules();
+            street_simulation.default_schedules();
             expected = DEFAULT_SCORE.at(data);
             std::cout
                 << "************************* default_schedules "
@@ -68,23 +91,35 @@ int main(int argc, char *argv[]) {
         }
         else if (option == "adaptive") {
             simulation.adaptive_schedules();
+            street_simulation.adaptive_schedules();
             expected = ADAPTIVE_SCORE.at(data);
             std::cout 
                 << "\n************************* adaptive_schedules "
                    "*************************\n";
         }
+        else if (option == "adaptive_scaled") {
+            simulation.create_schedules("adaptive", "scaled", ADAPTIVE_DIVISOR.at(data));
+            street_simulation.create_schedules("adaptive", "scaled", ADAPTIVE_DIVISOR.at(data));
+            expected = ADAPTIVE_SCALED_SCORE.at(data);
+            std::cout
+                << "\n********************** adaptive scaled schedules "
+                   "*********************\n";
+        }
         else if (option == "random") {
             simulation::set_seed(42);
             simulation.random_schedules();
             expected = simulation.score();
             simulation::set_seed(42);
             simulation.random_schedules();
+            simulation::set_seed(42);
+            street_simulation.random_schedules();
             std::cout
                 << "\n************************** random_schedules "
                    "**************************\n";
         }
         else if (option == "scaled") {
             simulation.scaled_schedules(27);
+            street_simulation.scaled_schedules(27);
             expected = simulation.score();
             std::cout
                 << "\n************************** scaled_schedules "
@@ -98,8 +133,67 @@ int main(int argc, char *argv[]) {
             "[" + option + "] Score mismatch: " + std::to_string(score)
             + " != " + std::to_string(expected)
         );
+
+        auto street_score = street_simulation.score();
+        assert_equal(
+            street_score, expected,
+            "[" + option + "] Street engine score mismatch: " + std::to_string(street_score)
+            + " != " + std::to_string(expected)
+        );
     }
 
+    // Updating some of the schedules must give the same schedules as setting all of them
+    auto adaptive = simulation::adaptive_simulation(city_plan);
+    auto adaptive_schedules = adaptive.non_trivial_schedules(true);
+    auto mixed_schedules = simulation::default_simulation(city_plan).non_trivial_schedules(true);
+    std::vector<unsigned long> indices;
+    std::vector<std::vector<unsigned long>> orders, times;
+    unsigned long changed = 0;
+    for (unsigned long i = 0; i < adaptive_schedules.size(); i += 2) {
+        indices.push_back(i);
+        orders.push_back(adaptive_schedules[i].first);
+        times.push_back(adaptive_schedules[i].second);
+        changed += mixed_schedules[i] != adaptive_schedules[i];
+        mixed_schedules[i] = adaptive_schedules[i];
+    }
+    auto updated = simulation::default_simulation(city_plan);
+    updated.clear_dirty_intersections();
+    updated.update_schedules(indices, orders, times, true);
+    assert_equal(updated.dirty_intersections().size(), changed, "[update_schedules] Wrong dirty intersections");
+
+    // An invalid schedule leaves all of the schedules untouched
+    if (!indices.empty()) {
+        auto hash = updated.schedules_hash();
+        auto invalid_indices = indices;
+        invalid_indices.back() = adaptive_schedules.size();
+        // The other schedules would change the valid intersections back to their default schedules
+        auto default_schedules = simulation::default_simulation(city_plan).non_trivial_schedules(true);
+        std::vector<std::vector<unsigned long>> default_orders, default_times;
+        for (auto i: indices) {
+            default_orders.push_back(default_schedules[i].first);
+            default_times.push_back(default_schedules[i].second);
+        }
+        try {
+            updated.update_schedules(invalid_indices, default_orders, default_times, true);
+            throw std::runtime_error{"[update_schedules] Invalid index accepted"};
+        }
+        catch (const std::invalid_argument &) {
+        }
+        assert_equal(updated.schedules_hash(), hash, "[update_schedules] Invalid update changed the schedules");
+    }
+
+    auto reference = simulation::default_simulation(city_plan);
+    reference.set_non_trivial_schedules(std::move(mixed_schedules), true);
+    assert_equal(
+        updated.schedules_hash(), reference.schedules_hash(), "[update_schedules] Schedules hash mismatch"
+    );
+    assert_equal(updated.score(), reference.score(), "[update_schedules] Score mismatch");
+
+    // Setting the same schedules again doesn't change any of them
+    updated.clear_dirty_intersections();
+    updated.set_non_trivial_schedules(reference.non_trivial_schedules());
+    assert_equal(updated.dirty_intersections().size(), 0, "[set_non_trivial_schedules] Unchanged schedules are dirty");
+
     auto score = city_plan.upper_bound();
     auto expected = UPPER_BOUND.at(data);
     assert_equal(
@@ -40,6 +40,12 @@ class TestScore(unittest.TestCase):
         simulation.summary()
         self.assertEqual(score, ADAPTIVE_SCORE[data])
 
+        simulation.create_schedules('adaptive', 'scaled', divisor=ADAPTIVE_DIVISOR[data])
+        score = simulation.score()
+        print('\n' + ' adaptive scaled schedules '.center(70, '*'))
+        simulation.summary()
+        self.assertEqual(score, ADAPTIVE_SCALED_SCORE[data])
+
         set_seed(42)
         simulation.random_schedules()
         score = simulation.score()
@@ -68,5 +74,78 @@ class TestScore(unittest.TestCase):
         upper_bound = plan.upper_bound()
         self.assertEqual(upper_bound, UPPER_BOUND[data])
 
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_street_engine(self, data):
+        plan = create_city_plan(data)
+        simulation = Simulation(plan)
+        simulation.engine = 'street'
+        self.assertEqual(simulation.engine, 'street')
+
+        simulation.default_schedules()
+        self.assertEqual(simulation.score(), DEFAULT_SCORE[data])
+        simulation.adaptive_schedules()
+        self.assertEqual(simulation.score(), ADAPTIVE_SCORE[data])
+        simulation.create_schedules('adaptive', 'scaled', divisor=ADAPTIVE_DIVISOR[data])
+        self.assertEqual(simulation.score(), ADAPTIVE_SCALED_SCORE[data])
+
+        simulation.scaled_schedules(divisor=BEST_DIVISOR[data])
+        score = simulation.score()
+        simulation.engine = 'car'
+        self.assertEqual(score, simulation.score())
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_update_schedules(self, data):
+        plan = create_city_plan(data)
+        adaptive_schedules = adaptive_simulation(plan).non_trivial_schedules(relative_order=True)
+        default_schedules = default_simulation(plan).non_trivial_schedules(relative_order=True)
+        mixed_schedules = list(default_schedules)
+        indices = list(range(0, len(adaptive_schedules), 2))
+        changed = sum(mixed_schedules[i] != adaptive_schedules[i] for i in indices)
+        for i in indices:
+            mixed_schedules[i] = adaptive_schedules[i]
+
+        # Updating some of the schedules must give the same schedules as setting all of them
+        updated = default_simulation(plan)
+        updated.clear_dirty_intersections()
+        updated.update_schedules(
+            indices, [adaptive_schedules[i][0] for i in indices], [adaptive_schedules[i][1] for i in indices],
+            relative_order=True,
+        )
+        self.assertEqual(len(updated.dirty_intersections), changed)
+
+        simulation = default_simulation(plan)
+        simulation.set_non_trivial_schedules(mixed_schedules, relative_order=True)
+        self.assertEqual(updated.schedules_hash, simulation.schedules_hash)
+        self.assertEqual(updated.score(), simulation.score())
+
+        # Setting the same schedules again doesn't change any of them
+        updated.clear_dirty_intersections()
+        updated.set_non_trivial_schedules(simulation.non_trivial_schedules())
+        self.assertEqual(updated.dirty_intersections, [])
+
+        # An invalid schedule leaves all of the schedules untouched
+        if indices:
+            schedules_hash = updated.schedules_hash
+            with self.assertRaises(ValueError):
+                updated.update_schedules(
+                    indices[:-1] + [len(adaptive_schedules)], [default_schedules[i][0] for i in indices],
+                    [default_schedules[i][1] for i in indices], relative_order=True,
+                )
+            self.assertEqual(updated.schedules_hash, schedules_hash)
+
 if __name__ == '__main__':
     unittest.main()
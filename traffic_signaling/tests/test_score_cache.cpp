@@ -0,0 +1,75 @@
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/evaluation_pool.hpp"
+#include "simulation/score_cache.hpp"
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto default_simulation = simulation::default_simulation(city_plan);
+    auto adaptive_simulation = simulation::adaptive_simulation(city_plan);
+    auto expected_default = default_simulation.score();
+    auto expected_adaptive = adaptive_simulation.score();
+
+    // The incrementally updated hash must match the hash of the same schedules created from scratch
+    auto replica = simulation::default_simulation(city_plan);
+    assert_equal(replica.schedules_hash(), default_simulation.schedules_hash(), "Hashes of equal schedules differ");
+    replica.set_non_trivial_schedules(adaptive_simulation.non_trivial_schedules(true), true);
+    assert_equal(
+        replica.schedules_hash(), adaptive_simulation.schedules_hash(), "Incrementally updated hash differs"
+    );
+    replica.set_non_trivial_schedules(default_simulation.non_trivial_schedules());
+    assert_equal(replica.schedules_hash(), default_simulation.schedules_hash(), "Hash differs after reverting");
+
+    auto cache = std::make_shared<simulation::ScoreCache>();
+    default_simulation.set_score_cache(cache);
+    replica.set_score_cache(cache);
+
+    assert_equal(default_simulation.score(), expected_default, "Score mismatch on a cache miss");
+    assert_equal(replica.score(), expected_default, "Score mismatch on a cache hit");
+    assert_equal(cache->misses(), 1, "Wrong number of cache misses");
+    assert_equal(cache->hits(), 1, "Wrong number of cache hits");
+
+    // The replicas of the pool share the cache with the simulations
+    simulation::EvaluationPool pool{city_plan, 2, cache};
+    for (int i = 0; i < 4; ++i) {
+        auto score = pool.submit(adaptive_simulation.non_trivial_schedules()).result();
+        assert_equal(score, expected_adaptive, "Pool score mismatch");
+    }
+    replica.set_non_trivial_schedules(adaptive_simulation.non_trivial_schedules());
+    assert_equal(replica.score(), expected_adaptive, "Score mismatch after changing the schedules");
+    assert_equal(cache->misses(), 2, "Wrong number of cache misses");
+    assert_equal(cache->hits(), 5, "Wrong number of cache hits");
+    assert_equal(cache->size(), 2, "Wrong cache size");
+
+    // The number of cached scores is bounded by the capacity
+    simulation::ScoreCache small_cache{2};
+    for (std::uint64_t key = 0; key < 3; ++key) {
+        small_cache.insert(key, key);
+    }
+    assert_equal(small_cache.size(), 2, "Cache exceeds its capacity");
+    assert_equal(small_cache.find(2).value_or(0), 2, "Last inserted score was evicted");
+    small_cache.clear();
+    assert_equal(small_cache.size() + small_cache.hits() + small_cache.misses(), 0, "Cache is not empty after clearing");
+
+    std::cout << "Cached scores match the simulation scores\n";
+}
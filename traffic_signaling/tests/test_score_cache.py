@@ -0,0 +1,50 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestScoreCache(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_score_cache(self, data):
+        plan = create_city_plan(data)
+        default = default_simulation(plan)
+        adaptive = adaptive_simulation(plan)
+        expected_default = default.score()
+        expected_adaptive = adaptive.score()
+
+        # The incrementally updated hash must match the hash of the same schedules created from scratch
+        replica = default_simulation(plan)
+        self.assertEqual(replica.schedules_hash, default.schedules_hash)
+        replica.set_non_trivial_schedules(adaptive.non_trivial_schedules(relative_order=True), relative_order=True)
+        self.assertEqual(replica.schedules_hash, adaptive.schedules_hash)
+        replica.set_non_trivial_schedules(default.non_trivial_schedules())
+        self.assertEqual(replica.schedules_hash, default.schedules_hash)
+
+        cache = ScoreCache()
+        default.score_cache = cache
+        replica.score_cache = cache
+        self.assertEqual(default.score(), expected_default)
+        self.assertEqual(replica.score(), expected_default)
+        self.assertEqual((cache.hits, cache.misses), (1, 1))
+
+        # The replicas of the pool share the cache with the simulations
+        pool = EvaluationPool(plan, threads=2, cache=cache)
+        for _ in range(4):
+            self.assertEqual(pool.submit(adaptive.non_trivial_schedules()).result(), expected_adaptive)
+        replica.set_non_trivial_schedules(adaptive.non_trivial_schedules())
+        self.assertEqual(replica.score(), expected_adaptive)
+        self.assertEqual((cache.hits, cache.misses, cache.size), (5, 2, 2))
+
+        replica.score_cache = None
+        self.assertIsNone(replica.score_cache)
+
+if __name__ == '__main__':
+    unittest.main()
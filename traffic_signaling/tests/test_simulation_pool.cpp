@@ -0,0 +1,84 @@
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulation/simulation_pool.hpp"
+
+using namespace std::string_literals; // for string operator""s
+
+using Schedules = std::vector<std::pair<std::vector<unsigned long>, std::vector<unsigned long>>>;
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    simulation::SimulationPool pool{city_plan, 3};
+
+    // A fresh replica is a clone of the template with the default schedules
+    auto reference = simulation::default_simulation(city_plan);
+    {
+        auto lease = pool.acquire();
+        assert_equal(lease->score(), reference.score(), "[clone] Score mismatch of a fresh replica");
+        lease.release();
+        assert_equal(lease.active(), false, "[release] Lease is still active after releasing it");
+    }
+
+    std::vector<std::string> options;
+    std::vector<Schedules> schedules;
+    std::vector<unsigned long> expected_scores;
+    for (auto &&schedule_option: {"default"s, "adaptive"s, "scaled"s}) {
+        if (schedule_option == "default") {
+            reference.default_schedules();
+        }
+        else if (schedule_option == "adaptive") {
+            reference.adaptive_schedules();
+        }
+        else if (schedule_option == "scaled") {
+            reference.scaled_schedules();
+        }
+        options.push_back(schedule_option);
+        schedules.push_back(reference.non_trivial_schedules());
+        expected_scores.push_back(reference.score());
+    }
+
+    // More threads than replicas, so some of them have to wait for a returned replica
+    std::atomic<unsigned long> mismatches{0};
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned long t = 0; t < 6; ++t) {
+            threads.emplace_back([&, t] {
+                for (unsigned long i = 0; i < 2 * schedules.size(); ++i) {
+                    auto index = (t + i) % schedules.size();
+                    auto lease = pool.acquire();
+                    auto copy = schedules[index];
+                    lease->set_non_trivial_schedules(std::move(copy));
+                    if (lease->score() != expected_scores[index]) {
+                        std::cout << "[" << options[index] << "] Score mismatch of a leased replica\n";
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+    }
+    assert_equal(mismatches, 0, "[lease] Leased replicas returned wrong scores");
+    assert_equal(pool.replicas() <= pool.max_replicas(), true, "[lease] Too many replicas");
+    assert_equal(pool.available(), pool.max_replicas(), "[lease] Replicas were not returned");
+    std::cout << "Leased replicas match the simulation scores\n";
+}
@@ -0,0 +1,58 @@
+import concurrent.futures
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestSimulationPool(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_lease(self, data):
+        plan = create_city_plan(data)
+        reference = default_simulation(plan)
+        pool = SimulationPool(plan, max_replicas=2)
+        self.assertEqual(pool.max_replicas, 2)
+        self.assertEqual(pool.replicas, 0)
+
+        # A fresh replica is a clone of the template with the default schedules
+        with pool.acquire() as simulation:
+            self.assertEqual(simulation.score(), reference.score())
+            self.assertEqual(pool.available, 1)
+        self.assertEqual(pool.available, 2)
+
+        lease = pool.acquire()
+        self.assertTrue(lease.active)
+        lease.release()
+        self.assertFalse(lease.active)
+        with self.assertRaises(RuntimeError):
+            lease.simulation
+
+        schedules = []
+        expected_scores = []
+        for schedule_option in ['default', 'adaptive', 'scaled']:
+            getattr(reference, f'{schedule_option}_schedules')()
+            schedules.append(reference.non_trivial_schedules())
+            expected_scores.append(reference.score())
+
+        def score(index):
+            with pool.acquire() as simulation:
+                simulation.set_non_trivial_schedules(schedules[index])
+                return simulation.score()
+
+        # More threads than replicas, so some of them have to wait for a returned replica
+        with concurrent.futures.ThreadPoolExecutor(max_workers=4) as executor:
+            indices = [i % len(schedules) for i in range(4 * len(schedules))]
+            for index, result in zip(indices, executor.map(score, indices)):
+                self.assertEqual(result, expected_scores[index])
+        self.assertLessEqual(pool.replicas, 2)
+        self.assertEqual(pool.available, 2)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+
+using namespace std::string_literals; // for string operator""s
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    auto duration = city_plan.duration();
+    simulation::Simulation simulation{city_plan};
+    // The replica uses the other engine, so that snapshots are also checked to be interchangeable between them
+    simulation::Simulation replica{city_plan};
+    replica.set_engine("street");
+
+    for (auto &&schedule_option: {"default"s, "adaptive"s, "scaled"s}) {
+        if (schedule_option == "default") {
+            simulation.default_schedules();
+            replica.default_schedules();
+        }
+        else if (schedule_option == "adaptive") {
+            simulation.adaptive_schedules();
+            replica.adaptive_schedules();
+        }
+        else if (schedule_option == "scaled") {
+            simulation.scaled_schedules();
+            replica.scaled_schedules();
+        }
+
+        auto expected = simulation.score();
+        for (auto time: {0UL, duration / 4, duration / 2, duration, duration + 1}) {
+            auto snapshot = simulation.snapshot(time);
+            auto msg = "[" + schedule_option + "] Score mismatch when resuming at time " + std::to_string(time) + ": ";
+
+            auto score = simulation.resume(snapshot);
+            assert_equal(score, expected, msg + std::to_string(score) + " != " + std::to_string(expected));
+
+            // The snapshot can be resumed by another simulation of the same city plan
+            score = replica.resume(snapshot);
+            assert_equal(score, expected, msg + std::to_string(score) + " != " + std::to_string(expected));
+        }
+    }
+
+    // Resuming from the start of the run with different schedules is the same as running them from scratch
+    simulation.default_schedules();
+    auto snapshot = simulation.snapshot(0);
+    replica.scaled_schedules();
+    auto expected = replica.score();
+    auto score = replica.resume(snapshot);
+    assert_equal(
+        score, expected,
+        "[different schedules] Score mismatch: " + std::to_string(score) + " != " + std::to_string(expected)
+    );
+
+    // The best rotation found by resuming a snapshot is the same as the best one found by full runs
+    simulation.scaled_schedules();
+    unsigned long index = 0;
+    unsigned long checked = 0;
+    for (auto &&intersection: city_plan.non_trivial_intersections()) {
+        auto schedules = simulation.non_trivial_schedules();
+        auto &&[order, times] = schedules[index++];
+        // Keep the number of full runs low on the large datasets
+        if (order.size() > 8) {
+            continue;
+        }
+        if (checked++ == 3) {
+            break;
+        }
+
+        std::pair<unsigned long, unsigned long> expected{0, 0};
+        for (unsigned long rotation = 0; rotation < order.size(); ++rotation) {
+            auto rotated_schedules = schedules;
+            auto &&[rotated_order, rotated_times] = rotated_schedules[index - 1];
+            std::ranges::rotate(rotated_order, rotated_order.begin() + static_cast<std::ptrdiff_t>(rotation));
+            std::ranges::rotate(rotated_times, rotated_times.begin() + static_cast<std::ptrdiff_t>(rotation));
+            replica.set_non_trivial_schedules(std::move(rotated_schedules));
+            auto score = replica.score();
+            if (rotation == 0 || score > expected.second) {
+                expected = {rotation, score};
+            }
+        }
+
+        simulation.clear_dirty_intersections();
+        auto [rotation, score] = simulation.optimize_rotation(intersection.id());
+        auto msg = "[rotation of intersection " + std::to_string(intersection.id()) + "] ";
+        assert_equal(rotation, expected.first, msg + "Rotation mismatch");
+        assert_equal(score, expected.second, msg + "Score mismatch");
+        // Keeping the original rotation doesn't mark the intersection as dirty
+        assert_equal(simulation.dirty_intersections().size(), rotation != 0, msg + "Dirty intersections mismatch");
+        // The best rotation is applied to the schedule
+        assert_equal(simulation.score(), expected.second, msg + "Best rotation is not applied");
+    }
+    std::cout << "Resumed snapshots match the full runs\n";
+}
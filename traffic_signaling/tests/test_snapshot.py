@@ -0,0 +1,87 @@
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestSnapshot(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_resume(self, data):
+        plan = create_city_plan(data)
+        for schedule_option in ['default', 'adaptive', 'scaled']:
+            simulation = Simulation(plan)
+            getattr(simulation, f'{schedule_option}_schedules')()
+            replica = Simulation(plan)
+            replica.engine = 'street'
+            getattr(replica, f'{schedule_option}_schedules')()
+
+            score = simulation.score()
+            for time in [0, plan.duration // 4, plan.duration // 2, plan.duration, plan.duration + 1]:
+                snapshot = simulation.snapshot(time)
+                self.assertEqual(snapshot.time, time)
+                self.assertEqual(score, simulation.resume(snapshot))
+                self.assertEqual(score, replica.resume(snapshot))
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_resume_different_schedules(self, data):
+        plan = create_city_plan(data)
+        snapshot = default_simulation(plan).snapshot(0)
+
+        simulation = Simulation(plan)
+        simulation.scaled_schedules(divisor=BEST_DIVISOR[data])
+        self.assertEqual(simulation.score(), simulation.resume(snapshot))
+
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_optimize_rotation(self, data):
+        plan = create_city_plan(data)
+        simulation = Simulation(plan)
+        simulation.scaled_schedules()
+        replica = Simulation(plan)
+        replica.scaled_schedules()
+
+        checked = 0
+        for index, intersection in enumerate(plan.non_trivial_intersections()):
+            schedules = simulation.non_trivial_schedules()
+            order, times = schedules[index]
+            # Keep the number of full runs low on the large datasets
+            if len(order) > 8:
+                continue
+            if checked == 3:
+                break
+            checked += 1
+
+            expected = None
+            for rotation in range(len(order)):
+                schedules[index] = (order[rotation:] + order[:rotation], times[rotation:] + times[:rotation])
+                replica.set_non_trivial_schedules(schedules)
+                score = replica.score()
+                if expected is None or score > expected[1]:
+                    expected = (rotation, score)
+
+            self.assertEqual(simulation.optimize_rotation(intersection.id), expected)
+            # The best rotation is applied to the schedule
+            self.assertEqual(simulation.score(), expected[1])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,4 +1,5 @@
 #include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -21,8 +22,8 @@ int main(int argc, char *argv[]) {
 
     std::cout
         << "------------------------------- DATA "
-        // Ad hoc way to get the data name from the input file name.
-        << input_file.substr(input_file.find(".txt") - 1, 1)
+        // The data name is the input file name without the extension (e.g. "a" or "grid_10x")
+        << std::filesystem::path{input_file}.stem().string()
         << " -------------------------------\n";
 
     std::chrono::high_resolution_clock::time_point start, end;
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simulation/simulation.hpp"
+#include "simulation/trace.hpp"
+
+using namespace std::string_literals; // for string operator""s
+
+void assert_equal(unsigned long a, unsigned long b, std::string_view msg = "") {
+    if (a != b) {
+        std::cout << msg << "\n";
+        throw std::runtime_error{msg.data()};
+    }
+}
+
+/**
+ * Replay the trace using only the city plan and return the score computed from the green light times.
+ */
+unsigned long replay_score(const city_plan::CityPlan &city_plan, const std::string &filename) {
+    simulation::TraceReader reader{filename};
+    assert_equal(reader.header().duration, city_plan.duration(), "[header] Duration mismatch");
+    assert_equal(reader.header().streets, city_plan.streets().size(), "[header] Street count mismatch");
+    assert_equal(reader.header().cars, city_plan.cars().size(), "[header] Car count mismatch");
+
+    auto &&offsets = city_plan.path_offsets();
+    auto &&street_ids = city_plan.path_street_ids();
+    std::vector<unsigned long> passes(city_plan.cars().size());
+    std::vector<unsigned long> last_green(city_plan.cars().size());
+    std::vector<bool> waiting(city_plan.cars().size());
+    unsigned long previous_time = 0;
+    while (auto record = reader.next()) {
+        auto car_id = record->car_id;
+        assert_equal(record->time >= previous_time, true, "[order] Records are not ordered by time");
+        assert_equal(record->arrival_time <= record->time, true, "[order] Car left before its arrival");
+        assert_equal(waiting[car_id], false, "[waiting] Car moved after waiting at the end");
+        assert_equal(
+            record->street_id, street_ids[offsets[car_id] + passes[car_id]], "[path] Car left the path"
+        );
+        previous_time = record->time;
+
+        if (record->event == simulation::TraceEvent::WAITING) {
+            waiting[car_id] = true;
+            continue;
+        }
+        ++passes[car_id];
+        last_green[car_id] = record->time;
+    }
+
+    unsigned long score = 0;
+    for (unsigned long car_id = 0; car_id < passes.size(); ++car_id) {
+        // The car drives its last street after the green light of the previous one
+        if (passes[car_id] + 1 != offsets[car_id + 1] - offsets[car_id]) {
+            continue;
+        }
+        auto finish_time = last_green[car_id] + city_plan.streets()[street_ids[offsets[car_id + 1] - 1]].length();
+        if (finish_time <= city_plan.duration()) {
+            score += city_plan.bonus() + city_plan.duration() - finish_time;
+        }
+    }
+    return score;
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> args{argv + 1, argv + argc};
+    auto &&input_file = args[0];
+    auto trace_file = args[1] + ".trace";
+
+    // Ad hoc way to get the data name from the input file name.
+    auto data = input_file.substr(input_file.find(".txt") - 1, 1);
+    std::cout
+        << "------------------------------- DATA " << data
+        << " -------------------------------\n";
+
+    city_plan::CityPlan city_plan{input_file};
+    simulation::Simulation simulation{city_plan};
+
+    for (auto &&engine: {"car"s, "street"s}) {
+        simulation.set_engine(engine);
+        for (auto &&schedule_option: {"default"s, "adaptive"s, "scaled"s}) {
+            if (schedule_option == "default") {
+                simulation.default_schedules();
+            }
+            else if (schedule_option == "adaptive") {
+                simulation.adaptive_schedules();
+            }
+            else if (schedule_option == "scaled") {
+                simulation.scaled_schedules();
+            }
+            auto expected_score = simulation.score();
+            auto msg = "[" + engine + ", " + schedule_option + "] ";
+            assert_equal(simulation.trace(trace_file), expected_score, msg + "Traced score mismatch");
+            assert_equal(replay_score(city_plan, trace_file), expected_score, msg + "Replayed score mismatch");
+        }
+    }
+    std::cout << "Replayed traces match the simulation scores\n";
+}
@@ -0,0 +1,35 @@
+import os
+import tempfile
+import unittest
+
+from parameterized import parameterized
+
+from _resolve_imports import *
+
+class TestTrace(unittest.TestCase):
+    @parameterized.expand([
+        ('a'),
+        ('b'),
+        ('c'),
+        ('d'),
+        ('e'),
+        ('f')
+    ])
+    def test_trace(self, data):
+        plan = create_city_plan(data)
+        with tempfile.TemporaryDirectory() as directory:
+            filename = os.path.join(directory, f'{data}.trace')
+            for schedule_option in ['default', 'adaptive', 'scaled']:
+                simulation = Simulation(plan)
+                getattr(simulation, f'{schedule_option}_schedules')()
+                self.assertEqual(simulation.trace(filename), simulation.score())
+                with open(filename, 'rb') as file:
+                    self.assertEqual(file.read(8), b'TSTRACE1')
+
+    def test_invalid_filename(self):
+        simulation = default_simulation(create_city_plan('a'))
+        with self.assertRaises(RuntimeError):
+            simulation.trace(os.path.join('nonexistent', 'directory', 'a.trace'))
+
+if __name__ == '__main__':
+    unittest.main()
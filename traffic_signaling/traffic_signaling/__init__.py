@@ -1,3 +1,4 @@
 from .city_plan import *
+from .evaluation_client import *
 from .simulation import *
 from .utils import *
@@ -1,3 +1,6 @@
+import numpy as np
+import numpy.typing as npt
+
 class Car:
     """
     Car in the city plan.
@@ -82,13 +85,6 @@ class Street:
         """
         ...
 
-    @property
-    def name(self) -> str:
-        """
-        Return the name of the street.
-        """
-        ...
-
     @property
     def used(self) -> bool:
         """
@@ -132,11 +128,14 @@ class CityPlan:
 
     Contains all information about intersections, streets, and cars known from the input data.
     """
-    def __init__(self, filename: str) -> None:
+    def __init__(self, filename: str, threads: int = ...) -> None:
         """
         Create a city plan from the input data file.
 
+        The cars are parsed on multiple threads, but the city plan is the same for any number of threads.
+
         :param filename: Path of the input data file.
+        :param threads: Maximum number of threads parsing the cars, by default the number of hardware threads.
         """
         ...
 
@@ -187,8 +186,109 @@ class CityPlan:
         """
         ...
 
+    @property
+    def street_starts(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the starting intersection IDs of the streets indexed by street IDs.
+        """
+        ...
+
+    @property
+    def street_ends(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the ending intersection IDs of the streets indexed by street IDs.
+        """
+        ...
+
+    @property
+    def street_lengths(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the lengths of the streets indexed by street IDs.
+        """
+        ...
+
+    @property
+    def street_total_cars(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the total numbers of cars that use the streets indexed by street IDs.
+        """
+        ...
+
+    @property
+    def path_offsets(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the offsets of the car paths in `path_street_ids` indexed by car IDs,
+        followed by the total length of all paths.
+
+        The path of the car with ID `i` is `path_street_ids[path_offsets[i]:path_offsets[i + 1]]`.
+        """
+        ...
+
+    @property
+    def path_street_ids(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the street IDs in the paths of all cars, one path after another.
+        """
+        ...
+
+    @property
+    def path_remaining_durations(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the free-flow durations from the end of each street in the paths of all cars
+        to their destinations, in the same order as `path_street_ids`.
+        """
+        ...
+
+    @property
+    def used_street_offsets(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the offsets of the used streets in `used_street_ids` indexed by intersection IDs,
+        followed by the number of all used streets.
+
+        The used streets of the intersection with ID `i` are `used_street_ids[used_street_offsets[i]:used_street_offsets[i + 1]]`,
+        in the same order as `Intersection.used_streets`.
+        """
+        ...
+
+    @property
+    def used_street_ids(self) -> npt.NDArray[np.uint64]:
+        """
+        Return a read-only array of the used street IDs of all intersections, one intersection after another.
+        """
+        ...
+
+    def street_id(self, name: str) -> int:
+        """
+        Return the ID of a street given its name.
+
+        Raises IndexError if there is no street with the name.
+
+        :param name: Name of the street.
+        """
+        ...
+
+    def street_name(self, street_id: int) -> str:
+        """
+        Return the name of a street given its ID.
+
+        :param street_id: ID of the street.
+        """
+        ...
+
     def upper_bound(self) -> int:
         """
         Return the theoretical maximum score if none of the cars ever has to wait at a traffic light.
         """
         ...
+
+    def earliest_arrival(self, intersection_id: int) -> int | None:
+        """
+        Return the earliest time any car can reach the traffic light of the given intersection,
+        or None if no car ever waits at it.
+
+        The time assumes that none of the cars has to wait at a traffic light, so it's a lower bound
+        for the time the first car reaches the traffic light with any schedules.
+
+        :param intersection_id: ID of the intersection.
+        """
+        ...
@@ -0,0 +1,114 @@
+from array import array
+import os
+import socket
+
+__all__ = ['EvaluationClient']
+
+# Request types and reply statuses of the evaluation daemon protocol.
+# See `include/evaluation_daemon/protocol.hpp` for the description of the protocol.
+_LOAD = 1
+_SCORE = 2
+_OK = 0
+
+# All values are sent as native 64-bit unsigned integers
+_WORD = 'Q'
+_WORD_SIZE = array(_WORD).itemsize
+
+
+class EvaluationClient:
+    """
+    Client of the evaluation daemon scoring schedules over a Unix domain socket.
+
+    The daemon keeps the loaded city plans and their evaluation pools resident,
+    so several processes can share them without paying the startup cost.
+    """
+    def __init__(self, socket_path: str) -> None:
+        """
+        Connect to the evaluation daemon.
+
+        :param socket_path: Path of the daemon's socket.
+        """
+        self._socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._socket.connect(socket_path)
+
+    def __enter__(self) -> 'EvaluationClient':
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.close()
+
+    def close(self) -> None:
+        """
+        Close the connection to the daemon.
+        """
+        self._socket.close()
+
+    def load(self, filename: str) -> int:
+        """
+        Load the city plan from the given file in the daemon and return its ID.
+
+        If the file is already loaded, the existing plan is reused.
+
+        :param filename: Path of the input file; relative paths are resolved by the client.
+        """
+        words = array(_WORD, [_LOAD])
+        words.extend(self._encode_string(os.path.abspath(filename)))
+        self._socket.sendall(words)
+        self._read_status()
+        return self._read_words(1)[0]
+
+    def score(
+        self, plan_id: int, batch: list[list[tuple[list[int], list[int]]]], relative_order: bool = False
+    ) -> list[int]:
+        """
+        Score a batch of schedules and return the scores in the same order.
+
+        The whole request is built before it's sent, so a schedule whose order and times have different sizes
+        raises ValueError without sending anything; it couldn't be encoded, because one length is sent for both.
+
+        :param plan_id: ID of the city plan returned by `load`.
+        :param batch: List of schedules, where each item is a list of `(order, times)` tuples
+        with a schedule for every non-trivial intersection.
+        :param relative_order: If True, `order` must be a list of street indices relative to each intersection.
+        Otherwise, `order` must be a list of street IDs.
+        """
+        words = array(_WORD, [_SCORE, plan_id, int(relative_order), len(batch)])
+        for schedules in batch:
+            words.append(len(schedules))
+            for order, times in schedules:
+                if len(times) != len(order):
+                    raise ValueError('Order and times of a schedule must have the same size')
+                words.append(len(order))
+                words.extend(iter(order))
+                words.extend(iter(times))
+        self._socket.sendall(words)
+        self._read_status()
+        size = self._read_words(1)[0]
+        return self._read_words(size).tolist()
+
+    @staticmethod
+    def _encode_string(string: str) -> array:
+        data = string.encode()
+        # Pad the string with zeros to a multiple of the word size
+        padding = -len(data) % _WORD_SIZE
+        words = array(_WORD, [len(data)])
+        words.frombytes(data + bytes(padding))
+        return words
+
+    def _read_status(self) -> None:
+        status = self._read_words(1)[0]
+        if status != _OK:
+            length = self._read_words(1)[0]
+            data = self._read_words((length + _WORD_SIZE - 1) // _WORD_SIZE).tobytes()
+            raise RuntimeError(data[:length].decode())
+
+    def _read_words(self, count: int) -> array:
+        data = bytearray()
+        while len(data) < count * _WORD_SIZE:
+            chunk = self._socket.recv(count * _WORD_SIZE - len(data))
+            if not chunk:
+                raise ConnectionError('Connection closed by the daemon')
+            data.extend(chunk)
+        words = array(_WORD)
+        words.frombytes(data)
+        return words
@@ -1,4 +1,4 @@
-from typing import Literal
+from typing import Literal, overload
 
 from .city_plan import CityPlan
 
@@ -40,6 +40,17 @@ class Schedule:
         """
         ...
 
+    @property
+    def hash(self) -> int:
+        """
+        Return the 64-bit hash of the schedule.
+
+        The hash is the XOR of the hashes of the `(position, street ID, time)` slots of the schedule,
+        so the hashes of several schedules can be combined and updated using XOR as well.
+        It is updated whenever the schedule changes. Empty schedules have the hash 0.
+        """
+        ...
+
     def relative_order(self) -> list[int]:
         """
         Return the order of streets in the schedule.
@@ -61,6 +72,512 @@ class Schedule:
         """
         ...
 
+class Snapshot:
+    """
+    Snapshot of a simulation run paused at a given time.
+
+    The snapshot can be resumed by any simulation of the same city plan, possibly with different schedules.
+    """
+    @property
+    def time(self) -> int:
+        """
+        Time at which the run was paused; all events occurring before this time have been processed.
+        """
+        ...
+
+    @property
+    def score(self) -> int:
+        """
+        Score accumulated by the cars that arrived at their destination before `time`.
+        """
+        ...
+
+class CarChange:
+    """
+    Car whose arrival differs between the runs of two sets of schedules.
+    """
+    @property
+    def car_id(self) -> int:
+        """
+        ID of the car.
+        """
+        ...
+
+    @property
+    def arrival_time(self) -> int | None:
+        """
+        Time the car arrived at its destination with the current schedules, or None if it hasn't arrived.
+        """
+        ...
+
+    @property
+    def other_arrival_time(self) -> int | None:
+        """
+        Time the car arrived at its destination with the other schedules, or None if it hasn't arrived.
+        """
+        ...
+
+    @property
+    def score_delta(self) -> int:
+        """
+        Score of the car with the other schedules minus its score with the current schedules.
+        """
+        ...
+
+class Comparison:
+    """
+    Result of comparing the current schedules of a simulation with other schedules.
+    """
+    @property
+    def score(self) -> int:
+        """
+        Score of the current schedules.
+        """
+        ...
+
+    @property
+    def other_score(self) -> int:
+        """
+        Score of the other schedules.
+        """
+        ...
+
+    @property
+    def score_delta(self) -> int:
+        """
+        Score of the other schedules minus the score of the current schedules.
+        """
+        ...
+
+    @property
+    def cars(self) -> list[CarChange]:
+        """
+        Cars whose arrival differs, ordered by car IDs.
+        """
+        ...
+
+class QueueStats:
+    """
+    Statistics of the queue of one street in a simulation run.
+    """
+    @property
+    def cars(self) -> int:
+        """
+        Number of cars that reached the traffic light at the end of the street.
+        """
+        ...
+
+    @property
+    def waiting_cars(self) -> int:
+        """
+        Number of cars that waited in the queue, including the cars still waiting at the end of the run.
+        """
+        ...
+
+    @property
+    def waiting_time(self) -> int:
+        """
+        Total time the cars waited in the queue, including the cars still waiting at the end of the run.
+        """
+        ...
+
+    @property
+    def max_queue(self) -> int:
+        """
+        Maximum number of cars waiting in the queue at the same time.
+        """
+        ...
+
+class AdaptiveVariant:
+    """
+    Adaptive schedules built by one construction run of `Simulation.adaptive_variants()`.
+    """
+    @property
+    def variant(self) -> int:
+        """
+        Index of the variant; variant 0 processes the cars in the order of their IDs.
+        """
+        ...
+
+    @property
+    def score(self) -> int:
+        """
+        Score of the schedules.
+        """
+        ...
+
+    @property
+    def schedules(self) -> list[tuple[list[int], list[int]]]:
+        """
+        Schedules of the non-trivial intersections in the format of `Simulation.non_trivial_schedules()`.
+        """
+        ...
+
+class SampledScore:
+    """
+    Score extrapolated from a run of a sample of the cars, see `Simulation.sampled_score()`.
+    """
+    @property
+    def estimate(self) -> int:
+        """
+        Estimate of the score of all cars.
+        """
+        ...
+
+    @property
+    def error(self) -> float:
+        """
+        Standard error of the estimate due to the choice of the cars.
+
+        It doesn't account for the bias caused by the queues being shorter than with all cars.
+        """
+        ...
+
+    @property
+    def score(self) -> int:
+        """
+        Score of the sampled cars.
+        """
+        ...
+
+    @property
+    def cars(self) -> int:
+        """
+        Number of sampled cars.
+        """
+        ...
+
+class IslandParameters:
+    """
+    Parameters of `island_genetic_algorithm()`; the defaults are the defaults of the genetic algorithm of the optimizer.
+    """
+    def __init__(self) -> None: ...
+
+    islands: int
+    """Number of islands, each evolved by its own thread."""
+
+    population: int
+    """Number of individuals of each island."""
+
+    generations: int
+    """Maximum number of generations of each island."""
+
+    crossover: float
+    """Probability of mating each pair of individuals."""
+
+    mutation: float
+    """Probability of mutating each individual."""
+
+    mutation_indpb: float
+    """Probability of mutating each street of a mutated individual (its position and its time)."""
+
+    max_time: int
+    """Largest green light time produced by mutations; 0 means the duration of the city plan."""
+
+    elitism: float
+    """Fraction of the best individuals passed to the next generation unchanged."""
+
+    tournsize: int
+    """Number of individuals in each tournament."""
+
+    migration_interval: int
+    """Number of generations between two migrations of an island."""
+
+    migrants: int
+    """Number of the best individuals sent to the next island in each migration."""
+
+    seed: int
+    """Seed of the random engines of the islands."""
+
+    target: int | None
+    """Score at which all islands stop, e.g. an upper bound of the score, or None."""
+
+class IslandGeneration:
+    """
+    Statistics of one generation of one island of `island_genetic_algorithm()`.
+    """
+    @property
+    def island(self) -> int:
+        """
+        Index of the island.
+        """
+        ...
+
+    @property
+    def generation(self) -> int:
+        """
+        Generation number; generation 0 is the initial population.
+        """
+        ...
+
+    @property
+    def evaluations(self) -> int:
+        """
+        Number of individuals evaluated in the generation.
+        """
+        ...
+
+    @property
+    def max_score(self) -> int:
+        """
+        Highest score in the population.
+        """
+        ...
+
+    @property
+    def average_score(self) -> float:
+        """
+        Average score of the population.
+        """
+        ...
+
+class IslandResult:
+    """
+    Result of `island_genetic_algorithm()`.
+    """
+    @property
+    def schedules(self) -> list[tuple[list[int], list[int]]]:
+        """
+        Schedules of the non-trivial intersections of the best individual, with relative orders.
+        """
+        ...
+
+    @property
+    def score(self) -> int:
+        """
+        Score of the best individual.
+        """
+        ...
+
+    @property
+    def history(self) -> list[IslandGeneration]:
+        """
+        Statistics of all generations of all islands, ordered by generations and islands.
+        """
+        ...
+
+    @property
+    def migrations(self) -> int:
+        """
+        Number of migrants received by the islands.
+        """
+        ...
+
+class ScoreCache:
+    """
+    Bounded cache of scores indexed by hashes of schedules.
+
+    The cache can be shared by several simulations of the same city plan running on different threads.
+    When it is full, the entries are evicted using the CLOCK algorithm (an approximation of LRU).
+    """
+    def __init__(self, capacity: int = 65536) -> None:
+        """
+        Create an empty score cache.
+
+        :param capacity: Maximum number of scores kept in the cache.
+        """
+        ...
+
+    def clear(self) -> None:
+        """
+        Remove all entries from the cache and reset the hit and miss counters.
+        """
+        ...
+
+    @property
+    def hits(self) -> int:
+        """
+        Return the number of lookups that found a score.
+        """
+        ...
+
+    @property
+    def misses(self) -> int:
+        """
+        Return the number of lookups that didn't find a score.
+        """
+        ...
+
+    @property
+    def size(self) -> int:
+        """
+        Return the number of scores in the cache.
+        """
+        ...
+
+    @property
+    def capacity(self) -> int:
+        """
+        Return the maximum number of scores kept in the cache.
+        """
+        ...
+
+class ScoreFuture:
+    """
+    Handle to a score calculated in the background by an EvaluationPool.
+    """
+    def result(self) -> int:
+        """
+        Wait until the score is calculated and return it.
+
+        If the calculation failed, the exception is raised.
+        """
+        ...
+
+    def done(self) -> bool:
+        """
+        Return True if the score is already calculated.
+        """
+        ...
+
+class EvaluationPool:
+    """
+    Pool of worker threads calculating scores of schedules in the background.
+
+    Each worker owns its own replica of the simulation, so the schedules are scored in parallel
+    while Python keeps working (e.g. producing the next schedules to score).
+    The workers can be pinned to CPUs to keep their replicas in the caches and memory of their cores.
+    """
+    def __init__(
+        self, city_plan: CityPlan, threads: int = ..., cache: ScoreCache | None = None, pin_threads: bool = False
+    ) -> None:
+        """
+        Create an evaluation pool for the given city plan.
+
+        The workers create their own replicas, so the memory of each replica is local to its worker.
+
+        :param city_plan: City plan containing information from the input file.
+        :param threads: Number of worker threads, by default the number of hardware threads.
+        :param cache: Score cache shared by the replicas of the workers, or None to disable caching.
+        :param pin_threads: If True, pin the workers to the CPUs the process may run on, one worker per CPU.
+        Pinning is supported only on Linux and ignored elsewhere.
+        """
+        ...
+
+    def submit(
+        self, schedules: list[tuple[list[int], list[int]]], relative_order: bool = False
+    ) -> ScoreFuture:
+        """
+        Submit schedules to be scored by one of the workers and return a handle to the score.
+
+        Raises ValueError if the number of schedules doesn't match the number of non-trivial intersections,
+        the order and the times of a schedule have different sizes, or the order contains an invalid street.
+
+        :param schedules: List of `(order, times)` tuples, where each tuple is a schedule for one intersection.
+        :param relative_order: If True, `order` must be a list of street indices relative to each intersection.
+        Otherwise, `order` must be a list of street IDs.
+        """
+        ...
+
+    @property
+    def threads(self) -> int:
+        """
+        Return the number of worker threads.
+        """
+        ...
+
+    @property
+    def pinned(self) -> bool:
+        """
+        Return True if every worker was pinned to a CPU.
+        """
+        ...
+
+    @property
+    def scored(self) -> list[int]:
+        """
+        Return the number of jobs scored by each worker so far.
+        """
+        ...
+
+class SimulationPool:
+    """
+    Bounded pool of simulation replicas leased to any thread.
+
+    The pool builds one template replica with the default schedules and creates the other replicas
+    lazily by copying it. A leased replica keeps the schedules set by its previous lessee,
+    so callers should set all schedules they want to score.
+    """
+    def __init__(self, city_plan: CityPlan, max_replicas: int = ..., cache: ScoreCache | None = None) -> None:
+        """
+        Create a simulation pool for the given city plan.
+
+        :param city_plan: City plan containing information from the input file.
+        :param max_replicas: Maximum number of replicas, by default the number of hardware threads.
+        :param cache: Score cache shared by the replicas, or None to disable caching.
+        """
+        ...
+
+    def acquire(self) -> SimulationLease:
+        """
+        Lease a replica, cloning a new one if all replicas are leased and the limit is not reached yet.
+
+        Blocks until a replica is returned if all `max_replicas` replicas are leased.
+        """
+        ...
+
+    @property
+    def replicas(self) -> int:
+        """
+        Return the number of replicas created so far, including the leased ones.
+        """
+        ...
+
+    @property
+    def available(self) -> int:
+        """
+        Return the number of replicas that can be leased without waiting.
+        """
+        ...
+
+    @property
+    def max_replicas(self) -> int:
+        """
+        Return the maximum number of replicas.
+        """
+        ...
+
+class SimulationLease:
+    """
+    Exclusive access to one replica of a SimulationPool.
+
+    The lease is a context manager returning the replica; the replica is returned to the pool
+    when the context is exited, the lease is released, or the lease is garbage collected.
+    """
+    @property
+    def simulation(self) -> Simulation:
+        """
+        Return the leased replica.
+
+        Raises RuntimeError if the lease was already released.
+        """
+        ...
+
+    @property
+    def active(self) -> bool:
+        """
+        Return True if the lease still holds a replica.
+        """
+        ...
+
+    def release(self) -> None:
+        """
+        Return the replica to the pool; releasing an inactive lease does nothing.
+        """
+        ...
+
+    def __enter__(self) -> Simulation:
+        """
+        Return the leased replica.
+        """
+        ...
+
+    def __exit__(self, *args: object) -> None:
+        """
+        Return the replica to the pool.
+        """
+        ...
+
 def set_seed(seed: int) -> None:
     """
     Set the random seed used for schedules generation.
@@ -104,12 +621,41 @@ class Simulation:
         """
         Create schedules for all used intersections and used streets.
 
+        Adaptive order assigns the slots of the schedules to the streets in the order their first cars
+        reach the intersections while running the simulation. With scaled times, each street gets a slot
+        as long as its scaled time instead of one second.
+
         :param order: Initialization option for the order of streets in the schedules.
         :param times: Initialization option for the green light times in the schedules.
         :param divisor: Divisor for the scaled times option.
         """
         ...
 
+    def adaptive_variants(
+        self, variants: int, times: Literal['default', 'scaled'] = 'default',
+        divisor: int = Schedule.DEFAULT_DIVISOR, seed: int = 0, threads: int = ...,
+        relative_order: bool = False,
+    ) -> list[AdaptiveVariant]:
+        """
+        Create adaptive schedules from several construction runs on multiple threads and keep the best ones.
+
+        Variant 0 is the same as `create_schedules('adaptive', times, divisor)`. The other variants add
+        the cars to their starting streets in random orders, which changes the order in which streets
+        reaching an intersection at the same time get their slots. Each variant is built on its own copy
+        of the simulation, and the random order of each variant only depends on the seed and its index.
+        The schedules of the best variant are set as the current schedules.
+
+        :param variants: Number of variants, at least 1.
+        :param times: Initialization option for the green light times in the schedules.
+        :param divisor: Divisor for the scaled times option.
+        :param seed: Seed of the random car orders.
+        :param threads: Maximum number of threads building the variants, by default the number of hardware threads.
+        :param relative_order: If True, the orders of the returned schedules contain street indices relative
+        to each intersection. Otherwise, they contain street IDs.
+        :return: All variants ordered from the highest score, ties in the order of the variants.
+        """
+        ...
+
     def default_schedules(self) -> None:
         """
         Create default schedules.
@@ -168,17 +714,256 @@ class Simulation:
         """
         ...
 
+    def update_schedules(
+        self, indices: list[int], orders: list[list[int]], times: list[list[int]], relative_order: bool = False
+    ) -> None:
+        """
+        Set the schedules of the given non-trivial intersections, leaving the other schedules untouched.
+
+        The memory of the updated schedules is reused, so updating a few intersections is much cheaper
+        than setting all non-trivial schedules. Schedules set to the same order and times are not marked
+        as changed. All schedules are validated before any of them is applied, so the schedules are left
+        untouched if `ValueError` is raised.
+
+        :param indices: Indices of the intersections in the non-trivial intersections of the city plan
+        (i.e. the same indices as in `non_trivial_schedules()`).
+        :param orders: Orders of streets of the updated schedules.
+        :param times: Green light times of the updated schedules.
+        :param relative_order: If True, `orders` must contain street indices relative to each intersection.
+        Otherwise, `orders` must contain street IDs.
+        """
+        ...
+
+    def compare(
+        self, indices: list[int], orders: list[list[int]], times: list[list[int]], relative_order: bool = False
+    ) -> Comparison:
+        """
+        Compare the current schedules with schedules that differ in the given non-trivial intersections.
+
+        Returns the score delta and the cars whose arrival changed. The run of the current schedules captures
+        a few snapshots until the latest time the first car can reach a non-trivial intersection. The other
+        schedules don't affect the run before the first car can reach any of the given intersections, so
+        the run of the other schedules is resumed from the latest snapshot before that time. The arrivals
+        and the snapshots of the current schedules are kept from the previous comparison if the schedules
+        didn't change since then, so comparing several candidates with the same schedules runs only
+        the part of the simulation of each candidate after its snapshot.
+        The current schedules are restored afterwards, and the intersections are not marked as changed,
+        but the run state is the resumed run of the other schedules.
+
+        :param indices: Indices of the intersections in the non-trivial intersections of the city plan
+        (i.e. the same indices as in `non_trivial_schedules()`).
+        :param orders: Orders of streets of the other schedules.
+        :param times: Green light times of the other schedules.
+        :param relative_order: If True, `orders` must contain street indices relative to each intersection.
+        Otherwise, `orders` must contain street IDs.
+        """
+        ...
+
+    def queue_stats(self) -> list[QueueStats]:
+        """
+        Return the statistics of the street queues in a run of the current schedules as a list indexed
+        by street IDs.
+
+        The cars still waiting at the end of the run are counted as waiting until the end. The statistics
+        are only collected on request, so the simulation is run first, unless the last complete run was
+        a run of the current schedules that already collected them.
+        """
+        ...
+
+    def rebalance_times(self, cycle: int | None = None) -> None:
+        """
+        Redistribute the green light times of all non-trivial intersections in proportion to the number
+        of cars that waited at each traffic light in a run of the current schedules, keeping the order
+        of the streets.
+
+        Each street reached by a car keeps one second for the cars passing on green, the streets no car
+        reached get no green light, and the remaining seconds of the cycle are split in proportion to
+        the waiting cars using the largest remainder method. Intersections that no car reached keep their
+        times, unless a target cycle length is given, which is then split evenly.
+
+        :param cycle: Cycle length of the rebalanced schedules (at least one second per street reached by a car),
+        or None to keep the cycle length of each schedule.
+        """
+        ...
+
+    @property
+    def dirty_intersections(self) -> list[int]:
+        """
+        Return the IDs of the intersections whose schedules changed since the last call
+        of `clear_dirty_intersections()`, in the order they were first changed.
+
+        Setting a non-trivial schedule to the same order and times doesn't mark it as changed.
+        """
+        ...
+
+    def clear_dirty_intersections(self) -> None:
+        """
+        Forget the intersections whose schedules changed.
+        """
+        ...
+
+    @property
+    def engine(self) -> str:
+        """
+        Event scheduling engine used to run the simulation, either 'car' or 'street'.
+
+        The 'car' engine keeps an event for every car waiting at a traffic light. The 'street' engine keeps
+        at most one event per street, which keeps the event queue small when long queues form.
+        Both engines give the same scores.
+        """
+        ...
+
+    @engine.setter
+    def engine(self, engine: str) -> None: ...
+
+    @property
+    def score_cache(self) -> ScoreCache | None:
+        """
+        Cache of scores used by `score()`, or None if there is none.
+
+        The cache can be shared by several simulations of the same city plan, including simulations
+        running on other threads, but it must not be shared with simulations of other city plans.
+        """
+        ...
+
+    @score_cache.setter
+    def score_cache(self, cache: ScoreCache | None) -> None: ...
+
+    @property
+    def schedules_hash(self) -> int:
+        """
+        Return the 64-bit hash of the current schedules.
+
+        The hash is the XOR of the hashes of all schedules, and it is updated incrementally
+        whenever some of the schedules change.
+        """
+        ...
+
+    @overload
     def score(self) -> int:
         """
         Calculate the score for the current setting of schedules.
 
-        This method runs the simulation.
+        This method runs the simulation. If a score cache is set and it already contains the score
+        of the current schedules, the cached score is returned without running the simulation. The run state
+        then still belongs to the previous run, so the methods reporting it run the simulation again.
+        """
+        ...
+
+    @overload
+    def score(self, horizon: int) -> int:
+        """
+        Run the simulation only until the given horizon and return an estimate of the full score.
+
+        The estimate is the score of the cars whose last traffic light is passed before the horizon, plus
+        partial credit for the cars still on their way: each of them is expected to reach its destination
+        after the free-flow duration of its remaining streets, waiting at each of its remaining traffic lights
+        as long as the cars waited on average per traffic light before the horizon. The cars expected after
+        the end of the simulation get no credit. The runtime grows with the horizon, and from the duration
+        of the simulation on, the estimate is the exact score.
+
+        Unlike `score()`, the estimate isn't cached, but the exact score is returned if the cache contains it.
+
+        :param horizon: Time until which the simulation is run.
+        """
+        ...
+
+    def set_car_sample(self, fraction: float, seed: int = 0) -> None:
+        """
+        Select a deterministic stratified sample of the cars for `sampled_score()`.
+
+        The cars are split into strata of equal sizes by the free-flow durations of their paths. Ordered by
+        their strata and then by the intersections they start at, every `1 / fraction`-th car is sampled from
+        a random offset, so every stratum and every part of the city is represented in proportion to its cars.
+        The sample only depends on the fraction and the seed.
+
+        Raises `ValueError` if the fraction is not in (0, 1].
+
+        :param fraction: Fraction of the cars to sample.
+        :param seed: Seed of the random offset.
+        """
+        ...
+
+    def clear_car_sample(self) -> None:
+        """
+        Remove the sample of the cars.
+        """
+        ...
+
+    @property
+    def car_sample(self) -> list[int]:
+        """
+        Return the IDs of the sampled cars in ascending order, or an empty list if no sample is set.
+        """
+        ...
+
+    def sampled_score(self) -> SampledScore:
+        """
+        Run the simulation with only the sampled cars and extrapolate the score of all cars.
+
+        The other cars never enter the streets. The estimate scales the score of the sampled cars of each stratum
+        by the size of the stratum. Fewer cars form shorter queues, so the estimate is biased upwards
+        on congested city plans (see `calibrate_car_sample()`); the reported error only covers the choice
+        of the cars. The score cache is bypassed, because the cached scores are the scores of all cars.
+
+        Raises `RuntimeError` if no sample is set, see `set_car_sample()`.
+        """
+        ...
+
+    def trace(self, filename: str) -> int:
+        """
+        Run the simulation while recording every car movement to a binary event trace, and return the score.
+
+        Each time a car gets the green light, a `PASS` record with the car, the street and the times of its arrival
+        at the traffic light and of the green light is written. The cars still waiting at the end of the run are
+        written as `WAITING` records. The score cache is bypassed, so the simulation is always run.
+        The trace can be inspected with the `replay_trace` tool.
+
+        :param filename: Path of the trace file.
+        """
+        ...
+
+    def snapshot(self, time: int) -> Snapshot:
+        """
+        Run the simulation until the given time and capture its state.
+
+        All events occurring before `time` are processed using the current schedules.
+
+        :param time: Time at which to pause the run.
+        """
+        ...
+
+    def resume(self, snapshot: Snapshot) -> int:
+        """
+        Resume the run captured in the snapshot and return the final score.
+
+        The current schedules are applied from the snapshot time onwards. Resuming with the same schedules
+        that were used to create the snapshot gives the same score as `score()`.
+
+        :param snapshot: Snapshot of a simulation of the same city plan.
+        """
+        ...
+
+    def optimize_rotation(self, intersection_id: int) -> tuple[int, int]:
+        """
+        Find the best cyclic rotation of the schedule of the given intersection and apply it.
+
+        Rotating the order (and the times with it) shifts when each street's green light starts within the cycle.
+        The run is paused when the first car can reach the intersection, and every rotation is evaluated by resuming
+        it, so the part of the run before that time is simulated only once. On ties, the smallest rotation is kept.
+
+        Returns a `(rotation, score)` tuple, where rotation `r` means the schedule starts with the street
+        at index `r` of the original order.
+
+        :param intersection_id: ID of the intersection with a schedule.
         """
         ...
 
     def summary(self) -> None:
         """
         Print a summary of the simulation statistics.
+
+        The simulation is run first, unless the last complete run was a run of the current schedules.
         """
         ...
 
@@ -208,3 +993,24 @@ def adaptive_simulation(city_plan: CityPlan) -> Simulation:
     :param city_plan: City plan containing information from the input file.
     """
     ...
+
+def island_genetic_algorithm(
+    city_plan: CityPlan, initial: list[list[tuple[list[int], list[int]]]],
+    parameters: IslandParameters = IslandParameters(), cache: ScoreCache | None = None
+) -> IslandResult:
+    """
+    Run a genetic algorithm with one population per island, each island evolved by its own thread
+    against its own simulation replica.
+
+    Each generation uses the same operators as `operators.py` of the optimizer. Every `migration_interval`
+    generations, an island sends copies of its best individuals to a lock-free queue of the next island
+    (the islands form a ring), which replaces its worst individuals with them. The islands never wait
+    for each other, so with more than one island the result also depends on the timing of the threads.
+
+    :param city_plan: City plan containing information from the input file.
+    :param initial: Initial individuals in the format of `Simulation.non_trivial_schedules(relative_order=True)`;
+        the islands take them in turns.
+    :param parameters: Parameters of the algorithm.
+    :param cache: Score cache shared by the replicas of the islands, or None to disable caching.
+    """
+    ...
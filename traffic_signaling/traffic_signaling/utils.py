@@ -1,10 +1,14 @@
 from importlib.resources import files
+import math
+import time
 
 try:
     from .city_plan import CityPlan
+    from .simulation import adaptive_simulation, default_simulation
     _anchor_str = 'traffic_signaling.data'
 except ImportError:
     from city_plan import CityPlan
+    from simulation import adaptive_simulation, default_simulation
     _anchor_str = 'data'
 
 # Short names of the datasets.
@@ -87,6 +91,26 @@ BEST_DIVISOR = {
     'f': 27,
 }
 
+# Best divisor (with the highest score) for adaptive schedules with scaled times for each dataset.
+ADAPTIVE_DIVISOR = {
+    'a': 1,
+    'b': 9,
+    'c': 17,
+    'd': 5,
+    'e': 2,
+    'f': 39,
+}
+
+# Score for each dataset with adaptive order and scaled times using `ADAPTIVE_DIVISOR`.
+ADAPTIVE_SCALED_SCORE = {
+    'a': 2_002,
+    'b': 4_568_650,
+    'c': 1_306_052,
+    'd': 2_481_644,
+    'e': 732_774,
+    'f': 1_382_455
+}
+
 def normalized_score(score: int, data: str) -> float:
     """
     Normalize the absolute score value between 0 and 1 for the given dataset.
@@ -127,3 +151,38 @@ def create_city_plan(data: str) -> CityPlan:
     :param data: Dataset name; ('a', 'b', 'c', 'd', 'e', 'f').
     """
     return CityPlan(get_data_filename(data))
+
+def calibrate_car_sample(data: str, fraction: float = 0.1, seeds: int = 5) -> dict[str, float]:
+    """
+    Measure the bias of `Simulation.sampled_score()` against the full `Simulation.score()` for the given dataset.
+
+    :param data: Dataset name; ('a', 'b', 'c', 'd', 'e', 'f').
+    :param fraction: Fraction of the sampled cars.
+    :param seeds: Number of samples (seeds) of each schedules.
+
+    The default and the adaptive schedules are scored with all cars and with each sample.
+    Returns a dictionary with the mean relative difference of the estimates from the scores (`bias`;
+    dividing an estimate by `1 + bias` corrects it), the root mean square of the relative differences (`rmse`),
+    the mean reported standard error relative to the scores (`error`) and how many times faster
+    the sampled runs are than the full ones (`speedup`).
+    """
+    plan = create_city_plan(data)
+    differences, errors = [], []
+    full_time = sampled_time = 0.0
+    for simulation in (default_simulation(plan), adaptive_simulation(plan)):
+        start = time.perf_counter()
+        score = simulation.score()
+        full_time += seeds * (time.perf_counter() - start)
+        for seed in range(seeds):
+            simulation.set_car_sample(fraction, seed)
+            start = time.perf_counter()
+            sampled = simulation.sampled_score()
+            sampled_time += time.perf_counter() - start
+            differences.append((sampled.estimate - score) / score)
+            errors.append(sampled.error / score)
+    return {
+        'bias': sum(differences) / len(differences),
+        'rmse': math.sqrt(sum(difference ** 2 for difference in differences) / len(differences)),
+        'error': sum(errors) / len(errors),
+        'speedup': full_time / sampled_time,
+    }